@@ -0,0 +1,262 @@
+#include "batch_runner.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+#include "metrics.h"
+#include "signals.h"
+
+namespace gol {
+
+BatchRunner::BatchRunner(int threads, int quantum, uint64_t masterSeed, std::ostream& out, ResultCache* cache)
+    : threads(std::max(1, threads)), masterSeed(masterSeed), scheduler(this->threads, quantum), out(out), cache(cache) {}
+
+int BatchRunner::run(std::istream& in) {
+    int rejected = 0;
+    std::string line;
+    for (int lineNumber = 1; !pollSignals() && std::getline(in, line); ++lineNumber) {
+        size_t first = line.find_first_not_of(" \t\r");
+        if (first == std::string::npos || line[first] == '#') continue;
+
+        Job job;
+        job.id = std::to_string(lineNumber);
+        std::string error;
+        if (parseJob(line, job, error) && (job.patternPath.empty() || loadPattern(job.patternPath, error))) {
+            if (!job.seeded) {
+                job.seed = deriveSeed(masterSeed, lineNumber);
+            }
+            submit(job);
+        } else {
+            rejected++;
+            writeLine("{\"type\":\"error\",\"job\":" + jsonString(job.id) + ",\"line\":" + std::to_string(lineNumber) +
+                      ",\"error\":" + jsonString(error) + "}");
+        }
+    }
+    scheduler.wait();
+
+    BoardScheduler::Stats stats = scheduler.stats();
+    std::ostringstream summary;
+    summary << "{\"type\":\"summary\",\"master_seed\":" << masterSeed << ",\"boards\":" << stats.boards << ",\"rejected\":" << rejected
+            << ",\"generations\":" << stats.generations << ",\"seconds\":" << stats.seconds
+            << ",\"boards_per_s\":" << stats.boardsPerSecond << ",\"gens_per_s\":" << stats.generationsPerSecond
+            << ",\"fairness\":" << stats.fairness << ",\"cache_hits\":" << cacheHits
+            << ",\"cache_entries\":" << (cache ? cache->size() : 0)
+            << ",\"stopped\":" << (pollSignals() ? "true" : "false") << "}";
+    writeLine(summary.str());
+    return rejected;
+}
+
+bool BatchRunner::pollSignals() {
+    if (statsRequested) {
+        statsRequested = 0;
+        BoardScheduler::Stats stats = scheduler.stats();
+        std::cerr << "boards=" << stats.boards << " generations=" << stats.generations << " seconds=" << stats.seconds
+                  << " boards_per_s=" << stats.boardsPerSecond << " gens_per_s=" << stats.generationsPerSecond
+                  << " cache_hits=" << cacheHits << "\n";
+    }
+    return stopRequested;
+}
+
+bool BatchRunner::parseJob(const std::string& line, Job& job, std::string& error) {
+    std::istringstream in(line);
+    std::string token;
+    while (in >> token) {
+        size_t eq = token.find('=');
+        if (eq == std::string::npos || eq == 0) {
+            error = "expected key=value, got '" + token + "'";
+            return false;
+        }
+        std::string key = token.substr(0, eq), value = token.substr(eq + 1);
+        char* end = nullptr;
+        bool ok = !value.empty();
+        if (key == "id") {
+            job.id = value;
+        } else if (key == "rule") {
+            ok = LifeRule::parse(value, job.rule);
+        } else if (key == "sym") {
+            ok = SymmetricSoup::parse(value, job.symmetry);
+        } else if (key == "pattern") {
+            job.patternPath = value;
+        } else if (key == "density") {
+            job.density = std::strtod(value.c_str(), &end);
+            ok = ok && *end == '\0' && job.density >= 0 && job.density <= 1;
+        } else if (key == "seed") {
+            job.seed = std::strtoull(value.c_str(), &end, 0);
+            job.seeded = true;
+            ok = ok && *end == '\0';
+        } else {
+            long number = std::strtol(value.c_str(), &end, 10);
+            ok = ok && *end == '\0';
+            if (key == "w") {
+                job.width = int(number);
+                ok = ok && number > 0;
+            } else if (key == "h") {
+                job.height = int(number);
+                ok = ok && number > 0;
+            } else if (key == "px") {
+                job.patternX = int(number);
+            } else if (key == "py") {
+                job.patternY = int(number);
+            } else if (key == "maxgen") {
+                job.maxGenerations = int(number);
+                ok = ok && number >= 0;
+            } else if (key == "soups") {
+                job.soups = int(number);
+                ok = ok && number >= 0;
+            } else {
+                error = "unknown key '" + key + "'";
+                return false;
+            }
+        }
+        if (!ok) {
+            error = "bad value for " + key + ": '" + value + "'";
+            return false;
+        }
+    }
+    if (SymmetricSoup::needsSquare(job.symmetry) && job.width != job.height) {
+        error = std::string(SymmetricSoup::name(job.symmetry)) + " soups need a square board";
+        return false;
+    }
+    return true;
+}
+
+bool BatchRunner::loadPattern(const std::string& path, std::string& error) {
+    if (patterns.count(path)) return true;
+    std::ifstream in(path);
+    std::stringstream text;
+    text << in.rdbuf();
+    Pattern pattern;
+    if (!in || !Pattern::parse(text.str(), pattern)) {
+        error = "cannot read pattern (plaintext or RLE, up to 62x62) from " + path;
+        return false;
+    }
+    patterns[path] = pattern;
+    return true;
+}
+
+void BatchRunner::submit(const Job& job) {
+    const Pattern* pattern = job.patternPath.empty() ? nullptr : &patterns[job.patternPath];
+    double density = job.density >= 0 ? job.density : pattern ? 0.0 : 0.5;
+    int px = job.patternX, py = job.patternY;
+    if (pattern) {
+        if (px < 0) px = (job.width - pattern->width) / 2;
+        if (py < 0) py = (job.height - pattern->height) / 2;
+    }
+
+    for (int soup = 0; soup < job.soups && !pollSignals(); ++soup) {
+        // Bound the boards in memory; a job file can ask for millions of soups.
+        scheduler.waitUntilBelow(uint64_t(threads) * 64);
+
+        uint64_t seed = deriveSeed(job.seed, soup);
+        std::unique_ptr<CellularAutomaton> board(new CellularAutomaton(job.width, job.height, 0, seed));
+        board->setRule(job.rule);
+        board->randomize(seed, density, job.symmetry);
+        if (pattern) {
+            board->placePattern(*pattern, px, py);
+        }
+
+        std::string prefix = "{\"type\":\"result\",\"job\":" + jsonString(job.id) + ",\"soup\":" + std::to_string(soup) +
+                             ",\"seed\":" + std::to_string(seed) + ",\"width\":" + std::to_string(job.width) +
+                             ",\"height\":" + std::to_string(job.height) + ",\"rule\":" + jsonString(job.rule.name()) +
+                             ",\"symmetry\":" + jsonString(SymmetricSoup::name(job.symmetry));
+
+        ResultCache::Key key;
+        key.initialHash = board->hash();
+        key.width = job.width;
+        key.height = job.height;
+        key.birth = job.rule.birth;
+        key.survive = job.rule.survive;
+        ResultCache::Outcome outcome;
+        // A fresh run only sees the board settle if its budget covers the tick after lifespan that detects it.
+        bool hit = cache && cache->lookup(key, outcome) && outcome.lifespan < job.maxGenerations;
+        if (cache) {
+            Metrics::recordResultCacheLookup(hit);
+        }
+        if (hit) {
+            BoardScheduler::Result result{};
+            result.generations = outcome.lifespan;
+            result.settled = true;
+            result.population = outcome.finalPopulation;
+            result.hash = outcome.finalHash;
+            cacheHits++;
+            writeResult(prefix, result, true, outcome, job.rule.isConway());
+            continue;
+        }
+
+        scheduler.submit(std::move(board), job.maxGenerations,
+                         [this, prefix, key, conway = job.rule.isConway()](const BoardScheduler::Result& result,
+                                                                           const CellularAutomaton& board) {
+            ResultCache::Outcome outcome;
+            if (result.settled) {
+                outcome.lifespan = result.generations;
+                outcome.period = board.settledPeriod();
+                outcome.finalPopulation = result.population;
+                outcome.finalHash = result.hash;
+                if (conway) {
+                    outcome.census = Census::take(board.cells(), board.boardWidth(), board.boardHeight());
+                }
+                if (cache) {
+                    cache->insert(key, outcome);
+                }
+            }
+            writeResult(prefix, result, false, outcome, conway);
+        });
+    }
+}
+
+void BatchRunner::writeResult(const std::string& prefix, const BoardScheduler::Result& result, bool cached,
+                              const ResultCache::Outcome& outcome, bool census) {
+    char hash[17];
+    std::snprintf(hash, sizeof(hash), "%016llx", static_cast<unsigned long long>(result.hash));
+    std::ostringstream line;
+    line << prefix << ",\"generations\":" << result.generations
+         << ",\"settled\":" << (result.settled ? "true" : "false") << ",\"population\":" << result.population
+         << ",\"hash\":\"" << hash << "\"";
+    if (result.settled) {
+        line << ",\"period\":" << outcome.period;
+    }
+    if (result.settled && census) {
+        line << ",\"census\":{";
+        const char* separator = "";
+        for (int kind = 0; kind < Census::KINDS; ++kind) {
+            if (outcome.census[kind] == 0) continue;
+            line << separator << "\"" << Census::name(kind) << "\":" << outcome.census[kind];
+            separator = ",";
+        }
+        line << "}";
+    }
+    if (cached) {
+        line << ",\"cached\":true}";
+    } else {
+        line << ",\"slices\":" << result.slices << ",\"run_us\":" << uint64_t(result.runSeconds * 1e6)
+             << ",\"turnaround_us\":" << uint64_t(result.turnaroundSeconds * 1e6) << "}";
+    }
+    writeLine(line.str());
+}
+
+void BatchRunner::writeLine(const std::string& line) {
+    std::lock_guard<std::mutex> lock(outMutex);
+    out << line << '\n' << std::flush; // Flushed per line so a reader on a pipe sees results as they finish
+}
+
+std::string BatchRunner::jsonString(const std::string& text) {
+    std::string s = "\"";
+    for (char c : text) {
+        if (c == '"' || c == '\\') {
+            s += '\\';
+            s += c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            char escaped[8];
+            std::snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+            s += escaped;
+        } else {
+            s += c;
+        }
+    }
+    return s + "\"";
+}
+
+} // namespace gol
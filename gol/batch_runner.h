@@ -0,0 +1,90 @@
+#ifndef GOL_BATCH_RUNNER_H
+#define GOL_BATCH_RUNNER_H
+
+#include <cstdint>
+#include <istream>
+#include <map>
+#include <mutex>
+#include <ostream>
+#include <string>
+
+#include "board_scheduler.h"
+#include "life_rule.h"
+#include "pattern.h"
+#include "result_cache.h"
+#include "seed.h"
+
+namespace gol {
+
+// Runs job specs read from a stream on one shared BoardScheduler and streams a JSON object per line as boards finish.
+//
+// One job per line, whitespace-separated key=value pairs; blank lines and lines starting with '#' are skipped:
+//   id=NAME        reported with every result (default: the line number)
+//   w=32 h=32      board size
+//   rule=B3/S23    life-like rule
+//   seed=N         the job's seed (default: derived from the runner's master seed and the line number)
+//   density=0.5    fraction of live cells in the random soup (default 0 if a pattern is given)
+//   sym=C1         soup symmetry: C1, C2, C4, D4 or D8 (C4 and D8 need w == h)
+//   pattern=FILE   plaintext or RLE pattern placed on the soup, centered unless px=/py= are given
+//   maxgen=10000   generation cap
+//   soups=1        number of boards to run from this spec
+//
+// Soup k of a job is seeded with deriveSeed(job seed, k), so every board, and so the whole output apart from timings
+// and line order, depends only on the master seed and the job file, not on the thread count or scheduling.
+//
+// Output lines have "type": "result" (one per board), "error" (one per bad job line) or "summary" (last).
+// Settled results carry their period and, under B3/S23 (the only rule Census knows), a census of the final board.
+//
+// Once installSignalHandlers() is in place, SIGUSR1 prints progress to stderr and SIGTERM stops reading jobs: boards
+// already submitted finish, and the summary says "stopped": true. Both are noticed between job lines and soups.
+//
+// With a ResultCache, each board is looked up before it is scheduled, and a hit is reported straight from the cache
+// ("cached": true) if it settled within this job's maxgen. Boards that settle are added to the cache. Each lookup is
+// counted in Metrics as a hit (served) or a miss (run), and the summary reports the entries the cache holds.
+class BatchRunner {
+public:
+    BatchRunner(int threads, int quantum, uint64_t masterSeed, std::ostream& out, ResultCache* cache = nullptr);
+
+    // Run every job in `in`, returning once all of them have finished. Returns the number of rejected job lines.
+    int run(std::istream& in);
+
+private:
+    struct Job {
+        std::string id;
+        int width = 32, height = 32;
+        LifeRule rule;
+        uint64_t seed = 0;
+        bool seeded = false;
+        double density = -1; // Unset: 0.5, or 0 with a pattern
+        SymmetricSoup::Symmetry symmetry = SymmetricSoup::C1;
+        std::string patternPath;
+        int patternX = -1, patternY = -1; // Unset: centered
+        int maxGenerations = 10000;
+        int soups = 1;
+    };
+
+    int threads;
+    uint64_t masterSeed;
+    BoardScheduler scheduler;
+    std::ostream& out;
+    ResultCache* cache;
+    uint64_t cacheHits = 0;
+    std::mutex outMutex;
+    std::map<std::string, Pattern> patterns; // Parsed pattern files, by path
+
+    // Handle a pending SIGUSR1; true once SIGTERM asked to stop.
+    bool pollSignals();
+
+    static bool parseJob(const std::string& line, Job& job, std::string& error);
+    bool loadPattern(const std::string& path, std::string& error);
+    void submit(const Job& job);
+    void writeLine(const std::string& line);
+    void writeResult(const std::string& prefix, const BoardScheduler::Result& result, bool cached,
+                     const ResultCache::Outcome& outcome, bool census);
+
+    static std::string jsonString(const std::string& text);
+};
+
+} // namespace gol
+
+#endif // GOL_BATCH_RUNNER_H
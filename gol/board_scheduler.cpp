@@ -0,0 +1,162 @@
+#include "board_scheduler.h"
+
+#include <algorithm>
+
+#include "metrics.h"
+
+namespace gol {
+
+BoardScheduler::BoardScheduler(int threads, int quantum, Callback onFinished)
+    : quantum(std::max(1, quantum)), onFinished(std::move(onFinished)) {
+    threads = std::max(1, threads);
+    busySeconds.assign(threads, 0.0);
+    for (int i = 0; i < threads; ++i) {
+        workers.emplace_back(&BoardScheduler::workerLoop, this, i);
+    }
+}
+
+BoardScheduler::~BoardScheduler() {
+    wait();
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    workAvailable.notify_all();
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+}
+
+uint64_t BoardScheduler::submit(std::unique_ptr<CellularAutomaton> board, int maxGenerations, Callback onFinished) {
+    std::unique_ptr<Job> job(new Job);
+    job->board = std::move(board);
+    job->maxGenerations = maxGenerations;
+    job->onFinished = std::move(onFinished);
+    job->submitted = std::chrono::steady_clock::now();
+
+    std::lock_guard<std::mutex> lock(mutex);
+    job->id = nextId++;
+    uint64_t id = job->id;
+    outstanding++;
+    fresh.push_back(std::move(job));
+    workAvailable.notify_one();
+    return id;
+}
+
+void BoardScheduler::wait() {
+    waitUntilBelow(1);
+}
+
+void BoardScheduler::waitUntilBelow(uint64_t count) {
+    std::unique_lock<std::mutex> lock(mutex);
+    boardFinished.wait(lock, [this, count] { return outstanding < count; });
+}
+
+BoardScheduler::Stats BoardScheduler::stats() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    Stats s;
+    s.boards = boardsDone;
+    s.generations = generationsDone;
+    s.slices = slicesDone;
+    s.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+    if (s.seconds > 0) {
+        s.boardsPerSecond = boardsDone / s.seconds;
+        s.generationsPerSecond = generationsDone / s.seconds;
+    }
+    if (boardsDone > 0) {
+        s.meanSlowdown = slowdownSum / boardsDone;
+        s.maxSlowdown = slowdownMax;
+        s.fairness = shareSquares > 0 ? shareSum * shareSum / (boardsDone * shareSquares) : 1;
+    }
+    auto busy = std::minmax_element(busySeconds.begin(), busySeconds.end());
+    s.workerBalance = *busy.second > 0 ? *busy.first / *busy.second : 1;
+    return s;
+}
+
+std::unique_ptr<BoardScheduler::Job> BoardScheduler::take() {
+    std::unique_lock<std::mutex> lock(mutex);
+    workAvailable.wait(lock, [this] { return stopping || !fresh.empty() || !running.empty(); });
+    if (stopping) {
+        return nullptr;
+    }
+
+    bool fromFresh = !fresh.empty() && (running.empty() || freshStreak < FRESH_BURST);
+    std::deque<std::unique_ptr<Job>>& queue = fromFresh ? fresh : running;
+    freshStreak = fromFresh ? freshStreak + 1 : 0;
+    std::unique_ptr<Job> job = std::move(queue.front());
+    queue.pop_front();
+    return job;
+}
+
+void BoardScheduler::workerLoop(int index) {
+    while (std::unique_ptr<Job> job = take()) {
+        CellularAutomaton& board = *job->board;
+        uint64_t cells = uint64_t(board.boardWidth()) * board.boardHeight();
+        auto sliceStart = std::chrono::steady_clock::now();
+        auto stepStart = sliceStart;
+
+        bool settled = false;
+        int budget = std::min(quantum, job->maxGenerations - job->generations);
+        for (int i = 0; i < budget; ++i) {
+            if (!board.tick()) {
+                settled = true;
+                break;
+            }
+            auto stepEnd = std::chrono::steady_clock::now();
+            Metrics::recordStep(cells, std::chrono::duration_cast<std::chrono::nanoseconds>(stepEnd - stepStart).count());
+            stepStart = stepEnd;
+            job->generations++;
+        }
+
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - sliceStart).count();
+        job->runSeconds += seconds;
+        job->slices++;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            busySeconds[index] += seconds;
+        }
+
+        if (settled || job->generations >= job->maxGenerations) {
+            if (settled) {
+                Metrics::recordSoupCompleted();
+            }
+            finish(std::move(job), settled);
+        } else {
+            std::lock_guard<std::mutex> lock(mutex);
+            running.push_back(std::move(job));
+            workAvailable.notify_one();
+        }
+    }
+}
+
+void BoardScheduler::finish(std::unique_ptr<Job> job, bool settled) {
+    Result result;
+    result.id = job->id;
+    result.generations = job->generations;
+    result.settled = settled;
+    result.population = job->board->population();
+    result.hash = job->board->hash();
+    result.slices = job->slices;
+    result.runSeconds = job->runSeconds;
+    result.turnaroundSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - job->submitted).count();
+    const Callback& callback = job->onFinished ? job->onFinished : onFinished;
+    if (callback) {
+        callback(result, *job->board);
+    }
+    job.reset();
+
+    double slowdown = result.runSeconds > 0 ? result.turnaroundSeconds / result.runSeconds : 1;
+    double share = 1 / std::max(slowdown, 1.0);
+    std::lock_guard<std::mutex> lock(mutex);
+    boardsDone++;
+    generationsDone += result.generations;
+    slicesDone += result.slices;
+    slowdownSum += slowdown;
+    slowdownMax = std::max(slowdownMax, slowdown);
+    shareSum += share;
+    shareSquares += share * share;
+    outstanding--;
+    boardFinished.notify_all();
+}
+
+} // namespace gol
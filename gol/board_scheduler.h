@@ -0,0 +1,106 @@
+#ifndef GOL_BOARD_SCHEDULER_H
+#define GOL_BOARD_SCHEDULER_H
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "cellular_automaton.h"
+
+namespace gol {
+
+// Runs many boards on a fixed pool of threads, so a batch of small soups costs no thread startup per board.
+// A worker takes a board, steps it for at most `quantum` generations and requeues it unless it finished. Boards
+// that have not had a slice yet go first, so short-lived soups finish within their first quantum or two, while
+// long-lived ones take turns instead of holding a thread until they settle.
+class BoardScheduler {
+public:
+    struct Result {
+        uint64_t id;
+        int generations;     // Generations stepped
+        bool settled;        // Reached a stable or period-2 state; otherwise it hit its generation cap
+        uint64_t population; // Of the final board
+        uint64_t hash;
+        int slices;
+        double runSeconds;   // Spent stepping
+        double turnaroundSeconds; // From submit() to completion
+    };
+
+    struct Stats {
+        uint64_t boards = 0, generations = 0, slices = 0;
+        double seconds = 0; // Since the scheduler was created
+        double boardsPerSecond = 0, generationsPerSecond = 0;
+        double meanSlowdown = 0, maxSlowdown = 0; // Turnaround over run time, per finished board
+        double fairness = 0;      // Jain's index of run / turnaround over finished boards: 1 = every board was served alike
+        double workerBalance = 0; // Least over most busy time across the workers: 1 = evenly loaded
+    };
+
+    // Called on a worker thread as each board finishes, just before the board is destroyed.
+    using Callback = std::function<void(const Result&, const CellularAutomaton&)>;
+
+    BoardScheduler(int threads, int quantum, Callback onFinished = nullptr);
+
+    // Waits for every submitted board.
+    ~BoardScheduler();
+
+    // Queue a board to run until it settles or reaches maxGenerations. Returns its Result::id. onFinished, if given,
+    // is called for this board instead of the scheduler-wide callback.
+    uint64_t submit(std::unique_ptr<CellularAutomaton> board, int maxGenerations, Callback onFinished = nullptr);
+
+    // Block until every submitted board has finished.
+    void wait();
+
+    // Block until fewer than `count` boards are queued or running, so a producer can bound memory use.
+    void waitUntilBelow(uint64_t count);
+
+    Stats stats() const;
+
+private:
+    struct Job {
+        uint64_t id;
+        std::unique_ptr<CellularAutomaton> board;
+        int maxGenerations;
+        int generations = 0;
+        int slices = 0;
+        double runSeconds = 0;
+        std::chrono::steady_clock::time_point submitted;
+        Callback onFinished;
+    };
+
+    static constexpr int FRESH_BURST = 8; // New boards served before a requeued one gets its turn
+
+    int quantum;
+    Callback onFinished;
+    std::chrono::steady_clock::time_point started = std::chrono::steady_clock::now();
+
+    mutable std::mutex mutex;
+    std::condition_variable workAvailable;
+    std::condition_variable boardFinished;
+    std::deque<std::unique_ptr<Job>> fresh;   // Not yet run
+    std::deque<std::unique_ptr<Job>> running; // Preempted at the end of a quantum
+    int freshStreak = 0;
+    uint64_t nextId = 0;
+    uint64_t outstanding = 0;
+    bool stopping = false;
+
+    // Totals over finished boards, under mutex.
+    uint64_t boardsDone = 0, generationsDone = 0, slicesDone = 0;
+    double slowdownSum = 0, slowdownMax = 0, shareSum = 0, shareSquares = 0;
+    std::vector<double> busySeconds; // Per worker
+
+    std::vector<std::thread> workers;
+
+    std::unique_ptr<Job> take(); // nullptr when stopping
+    void workerLoop(int index);
+    void finish(std::unique_ptr<Job> job, bool settled);
+};
+
+} // namespace gol
+
+#endif // GOL_BOARD_SCHEDULER_H
@@ -0,0 +1,132 @@
+#include "c_api.h"
+
+#include <memory>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "engine.h"
+
+struct gol_board {
+    std::unique_ptr<gol::Engine> engine;
+};
+
+namespace {
+
+// Registry names, copied once so gol_engine_name can hand out pointers that never move.
+const std::vector<std::string>& engineNames() {
+    static const std::vector<std::string> names = gol::EngineRegistry::instance().names();
+    return names;
+}
+
+bool validRegion(int w, int h, const void* cells) {
+    return cells && w >= 0 && h >= 0;
+}
+
+} // namespace
+
+// Nothing may throw across the C boundary; allocation failures become GOL_ERR_NO_MEMORY.
+extern "C" {
+
+int gol_api_version(void) {
+    return GOL_API_VERSION;
+}
+
+size_t gol_engine_count(void) {
+    return engineNames().size();
+}
+
+const char* gol_engine_name(size_t index) {
+    return index < engineNames().size() ? engineNames()[index].c_str() : nullptr;
+}
+
+gol_board* gol_board_create(const char* engine, int width, int height) {
+    if (width <= 0 || height <= 0)
+        return nullptr;
+    try {
+        std::unique_ptr<gol_board> board(new gol_board);
+        board->engine = gol::EngineRegistry::instance().create(engine ? engine : "default", width, height);
+        return board->engine ? board.release() : nullptr;
+    } catch (const std::bad_alloc&) {
+        return nullptr;
+    }
+}
+
+void gol_board_destroy(gol_board* board) {
+    delete board;
+}
+
+int gol_board_width(const gol_board* board) {
+    return board ? board->engine->width() : 0;
+}
+
+int gol_board_height(const gol_board* board) {
+    return board ? board->engine->height() : 0;
+}
+
+int gol_board_step(gol_board* board, int generations) {
+    if (!board || generations < 0)
+        return GOL_ERR_INVALID;
+    try {
+        board->engine->step(generations);
+    } catch (const std::bad_alloc&) {
+        return GOL_ERR_NO_MEMORY;
+    }
+    return GOL_OK;
+}
+
+int gol_board_get_cells(const gol_board* board, int x, int y, int w, int h, uint8_t* cells) {
+    if (!board || !validRegion(w, h, cells))
+        return GOL_ERR_INVALID;
+    try {
+        gol::DynamicBitset region = board->engine->getRegion(x, y, w, h);
+        for (size_t i = 0; i < size_t(w) * h; i++)
+            cells[i] = region.test(i);
+    } catch (const std::bad_alloc&) {
+        return GOL_ERR_NO_MEMORY;
+    }
+    return GOL_OK;
+}
+
+int gol_board_set_cells(gol_board* board, int x, int y, int w, int h, const uint8_t* cells) {
+    if (!board || !validRegion(w, h, cells))
+        return GOL_ERR_INVALID;
+    try {
+        gol::DynamicBitset region(size_t(w) * h);
+        for (size_t i = 0; i < size_t(w) * h; i++)
+            region.set(i, cells[i] != 0);
+        board->engine->setRegion(x, y, w, h, region);
+    } catch (const std::bad_alloc&) {
+        return GOL_ERR_NO_MEMORY;
+    }
+    return GOL_OK;
+}
+
+int gol_board_stats(const gol_board* board, gol_stats* stats) {
+    if (!board || !stats)
+        return GOL_ERR_INVALID;
+    gol::EngineStats s = board->engine->stats();
+    stats->generation = s.generation;
+    stats->population = s.population;
+    stats->step_calls = s.stepCalls;
+    stats->step_micros = s.stepMicros;
+    return GOL_OK;
+}
+
+uint64_t gol_board_hash(const gol_board* board) {
+    return board ? board->engine->hash() : 0;
+}
+
+int gol_board_buffer(const gol_board* board, const uint64_t** words, size_t* word_count, size_t* stride_bits) {
+    if (!board || !words || !word_count || !stride_bits)
+        return GOL_ERR_INVALID;
+    gol::CellBuffer cells = board->engine->cellBuffer();
+    if (!cells.words)
+        return GOL_ERR_UNSUPPORTED;
+    *words = cells.words;
+    *word_count = cells.wordCount;
+    *stride_bits = cells.strideBits;
+    return GOL_OK;
+}
+
+} // extern "C"
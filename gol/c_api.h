@@ -0,0 +1,81 @@
+/*
+ * Plain C interface to the gol library, built as libgol.so.
+ *
+ * Boards are opaque handles. Functions that can fail return GOL_OK or a negative gol_status.
+ *
+ * Thread safety: different boards are independent and may be used from different threads at the same time.
+ * Calls on one board are not synchronized, so the caller must serialize them, and that includes reads
+ * through the gol_board_buffer() pointer while a step or edit on the same board is in progress.
+ */
+
+#ifndef GOL_C_API_H
+#define GOL_C_API_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define GOL_API __attribute__((visibility("default")))
+
+/* Bumped whenever a function or struct below changes incompatibly. */
+#define GOL_API_VERSION 1
+
+typedef enum gol_status {
+    GOL_OK = 0,
+    GOL_ERR_INVALID = -1,     /* Null handle or pointer, or an out-of-range argument */
+    GOL_ERR_NO_MEMORY = -2,
+    GOL_ERR_UNSUPPORTED = -3  /* The board's engine cannot do this (e.g. it has no packed buffer) */
+} gol_status;
+
+typedef struct gol_board gol_board;
+
+typedef struct gol_stats {
+    uint64_t generation;
+    uint64_t population;
+    uint64_t step_calls;
+    uint64_t step_micros;  /* Wall time spent stepping, summed over all gol_board_step calls */
+} gol_stats;
+
+/* GOL_API_VERSION of the loaded library; compare with the header's to detect a mismatch. */
+GOL_API int gol_api_version(void);
+
+/* Names of the available engines, 0 <= index < gol_engine_count(). The strings live as long as the library. */
+GOL_API size_t gol_engine_count(void);
+GOL_API const char* gol_engine_name(size_t index);
+
+/* A width x height board with every cell dead, run by the named engine (NULL for "default").
+ * Returns NULL if the engine does not exist, the size is not positive, or allocation fails. */
+GOL_API gol_board* gol_board_create(const char* engine, int width, int height);
+GOL_API void gol_board_destroy(gol_board* board);
+
+GOL_API int gol_board_width(const gol_board* board);
+GOL_API int gol_board_height(const gol_board* board);
+
+/* Advance exactly `generations` (>= 0) generations. */
+GOL_API int gol_board_step(gol_board* board, int generations);
+
+/* Copy the w x h rectangle at (x, y) to/from `cells`, one byte per cell (0 dead, nonzero alive), row-major.
+ * Cells off the board read as dead and are ignored when written. */
+GOL_API int gol_board_get_cells(const gol_board* board, int x, int y, int w, int h, uint8_t* cells);
+GOL_API int gol_board_set_cells(gol_board* board, int x, int y, int w, int h, const uint8_t* cells);
+
+GOL_API int gol_board_stats(const gol_board* board, gol_stats* stats);
+
+/* Hash of the board contents and dimensions; 0 for a null handle. */
+GOL_API uint64_t gol_board_hash(const gol_board* board);
+
+/* Zero-copy view of the board: *words points at *word_count 64-bit words, and cell (x, y) is bit
+ * (y * *stride_bits + x), counting from the least significant bit of words[0]. stride_bits is the width for the
+ * "default" engine and a multiple of 64 (word-aligned rows) for the "bits/..." engines. Engines may swap buffers
+ * when they step, so call this again after every step or edit. Returns GOL_ERR_UNSUPPORTED if the engine does not
+ * keep one bit per cell (e.g. the "bytes/..." engines). */
+GOL_API int gol_board_buffer(const gol_board* board, const uint64_t** words, size_t* word_count, size_t* stride_bits);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* GOL_C_API_H */
@@ -0,0 +1,65 @@
+#ifndef GOL_CELL_AGES_H
+#define GOL_CELL_AGES_H
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "dynamic_bitset.h"
+
+namespace gol {
+
+// Per-cell age (generations a cell has been continuously alive), as nibble-packed saturating counters:
+// 16 cells per 64-bit word, capped at 15. One pass per generation updates 16 cells at a time.
+class CellAges {
+public:
+    static constexpr int MAX_AGE = 15;
+
+    CellAges(int width, int height)
+        : width(width), ages((size_t(width) * height + 63) / 64 * 4, 0) {
+        for (int b = 0; b < 256; ++b) {
+            uint32_t nibbles = 0;
+            for (int i = 0; i < 8; ++i) {
+                if (b & (1 << i)) nibbles |= uint32_t(0xF) << (4 * i);
+            }
+            nibbleMask[b] = nibbles;
+        }
+    }
+
+    // Age every live cell by one (saturating) and zero every dead one.
+    void update(const DynamicBitset& grid) {
+        const uint64_t ONES = 0x1111111111111111ULL;
+        const uint64_t* cells = grid.wordData();
+        for (size_t w = 0; w < grid.words(); ++w) {
+            uint64_t alive = cells[w];
+            uint64_t* lane = &ages[w * 4];
+            for (int part = 0; part < 4; ++part, alive >>= 16) {
+                uint64_t mask = uint64_t(nibbleMask[alive & 0xFF]) |
+                                (uint64_t(nibbleMask[(alive >> 8) & 0xFF]) << 32);
+                uint64_t a = lane[part];
+                uint64_t full = a & (a >> 1) & (a >> 2) & (a >> 3) & ONES; // Nibbles at 15
+                lane[part] = (a + (ONES & ~full)) & mask;
+            }
+        }
+    }
+
+    // Forget all history: every live cell starts again at age 1, as for a fresh board.
+    void reset(const DynamicBitset& grid) {
+        std::fill(ages.begin(), ages.end(), 0);
+        update(grid);
+    }
+
+    int at(int x, int y) const {
+        size_t index = size_t(y) * width + x;
+        return (ages[index >> 4] >> ((index & 15) * 4)) & 0xF;
+    }
+
+private:
+    int width;
+    std::vector<uint64_t> ages;
+    uint32_t nibbleMask[256]; // Byte of bits -> 0xF per set bit
+};
+
+} // namespace gol
+
+#endif // GOL_CELL_AGES_H
@@ -0,0 +1,708 @@
+#include "cellular_automaton.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <sys/ioctl.h>
+#include <unistd.h>
+
+#include "frame_pacer.h"
+#include "metrics.h"
+#include "signals.h"
+
+namespace gol {
+
+CellularAutomaton::CellularAutomaton(int width, int height, int speed, uint64_t seed)
+    : width(width), height(height), speed(speed), initialSeed(seed),
+      grid(size_t(width) * height), nextGrid(size_t(width) * height), prevGrid(size_t(width) * height)
+{
+    initializeRandom();
+    changedTiles.reset(new ChangedTiles(width, height));
+    activeTiles.reset(new ChangedTiles(width, height));
+    editedTiles.reset(new ChangedTiles(width, height));
+    gridReplaced();
+}
+
+CellularAutomaton::CellularAutomaton(int width, int height, int speed)
+    : CellularAutomaton(width, height, speed, uint64_t(std::random_device()()) << 32 | std::random_device()())
+{
+}
+
+void CellularAutomaton::enableHeatmap(int window, const std::string& pgmPath, bool showHeatmap) {
+    heatmap.reset(new ActivityHeatmap(width, height, window));
+    heatmapPath = pgmPath;
+    heatmapDisplay = showHeatmap;
+}
+
+void CellularAutomaton::enableAges() {
+    ages.reset(new CellAges(width, height));
+    ages->update(grid);
+}
+
+void CellularAutomaton::enableFrameExport(FrameExporter::Format format, const std::string& prefix, int threads) {
+    exporter.reset(new FrameExporter(width, height, format, prefix, threads));
+}
+
+bool CellularAutomaton::enableSharedFrames(const std::string& name) {
+    sharedFrames.reset(new SharedFramePublisher(name, width, height));
+    if (!sharedFrames->ok()) {
+        sharedFrames.reset();
+        return false;
+    }
+    return true;
+}
+
+bool CellularAutomaton::enableFrameServer(const std::string& path) {
+    server.reset(new FrameServer(path, width, height));
+    if (!server->ok()) {
+        server.reset();
+        return false;
+    }
+    return true;
+}
+
+void CellularAutomaton::setCheckpointPath(const std::string& path) {
+    checkpointPath = path;
+}
+
+bool CellularAutomaton::saveCheckpoint(const std::string& path) const {
+    std::string tmp = path + ".tmp";
+    {
+        std::ofstream out(tmp, std::ios::binary);
+        int32_t header[3] = {width, height, generation};
+        out.write("GOLCKPT1", 8);
+        out.write(reinterpret_cast<const char*>(header), sizeof(header));
+        out.write(reinterpret_cast<const char*>(grid.wordData()), grid.words() * sizeof(uint64_t));
+        out.write(reinterpret_cast<const char*>(prevGrid.wordData()), prevGrid.words() * sizeof(uint64_t));
+        if (!out) return false;
+    }
+    return std::rename(tmp.c_str(), path.c_str()) == 0;
+}
+
+bool CellularAutomaton::loadCheckpoint(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    char magic[8];
+    int32_t header[3];
+    in.read(magic, 8);
+    in.read(reinterpret_cast<char*>(header), sizeof(header));
+    if (!in || std::memcmp(magic, "GOLCKPT1", 8) != 0) {
+        std::cerr << "Not a checkpoint file: " << path << "\n";
+        return false;
+    }
+    if (header[0] != width || header[1] != height) {
+        std::cerr << "Checkpoint is " << header[0] << "x" << header[1] << ", board is " << width << "x" << height << "\n";
+        return false;
+    }
+    in.read(reinterpret_cast<char*>(grid.wordData()), grid.words() * sizeof(uint64_t));
+    in.read(reinterpret_cast<char*>(prevGrid.wordData()), prevGrid.words() * sizeof(uint64_t));
+    if (!in) {
+        std::cerr << "Truncated checkpoint: " << path << "\n";
+        return false;
+    }
+    generation = header[2];
+    if (history) {
+        history->clear();
+    }
+    if (rewind) {
+        rewind->clear();
+    }
+    gridReplaced();
+    return true;
+}
+
+void CellularAutomaton::enableRewind(size_t capacity, int keyframeInterval) {
+    rewind.reset(new RewindBuffer(capacity, keyframeInterval));
+    rewind->record(grid, generation, nullptr);
+}
+
+bool CellularAutomaton::regionAt(int x, int y, int w, int h, int generations, DynamicBitset& out) {
+    if (!rule.isConway()) return false;
+    if (!lightCone) {
+        lightCone.reset(new LightCone(width, height));
+    }
+    out = lightCone->query(grid, stateVersion, x, y, w, h, std::max(0, generations));
+    return true;
+}
+
+void CellularAutomaton::step(int generations) {
+    for (int i = 0; i < generations; ++i) {
+        computeNext();
+        advance();
+        generation++;
+    }
+}
+
+bool CellularAutomaton::tick() {
+    if (!update()) {
+        return false;
+    }
+    generation++;
+    return true;
+}
+
+uint64_t CellularAutomaton::population() const {
+    uint64_t count = 0;
+    for (size_t w = 0; w < grid.words(); ++w) {
+        count += __builtin_popcountll(grid.wordData()[w]);
+    }
+    return count;
+}
+
+uint64_t CellularAutomaton::hash() const {
+    return grid.hash() ^ (uint64_t(uint32_t(width)) << 32 | uint32_t(height)) * 0x9E3779B97F4A7C15ULL;
+}
+
+DynamicBitset CellularAutomaton::region(int x, int y, int w, int h) const {
+    DynamicBitset out(size_t(std::max(w, 0)) * std::max(h, 0));
+    for (int row = 0; row < h; ++row) {
+        for (int col = 0; col < w; ++col) {
+            int bx = x + col, by = y + row;
+            if (bx >= 0 && by >= 0 && bx < width && by < height) {
+                out.set(size_t(row) * w + col, grid.test(size_t(by) * width + bx));
+            }
+        }
+    }
+    return out;
+}
+
+void CellularAutomaton::setRegion(int x, int y, int w, int h, const DynamicBitset& cells) {
+    for (int row = 0; row < h; ++row) {
+        for (int col = 0; col < w; ++col) {
+            editCell(x + col, y + row, cells.test(size_t(row) * w + col));
+        }
+    }
+    finishEdits();
+}
+
+void CellularAutomaton::clear() {
+    grid.reset();
+    prevGrid.reset();
+    gridReplaced();
+}
+
+void CellularAutomaton::randomize(uint64_t seed, double density, SymmetricSoup::Symmetry symmetry) {
+    SplitMix64 random(seed);
+    initialSeed = seed;
+    grid = SymmetricSoup::generate(width, height, symmetry, density, random);
+    prevGrid.reset();
+    gridReplaced();
+}
+
+void CellularAutomaton::placePattern(const Pattern& pattern, int x, int y) {
+    for (int py = 0; py < pattern.height; ++py) {
+        for (int px = 0; px < pattern.width; ++px) {
+            if (pattern.test(px, py)) {
+                editCell(x + px, y + py, true);
+            }
+        }
+    }
+    finishEdits();
+}
+
+bool CellularAutomaton::setRule(const LifeRule& newRule) {
+    if (tracker && !newRule.isConway()) return false;
+
+    // The board itself is unchanged, so ages, the pyramid and history stay; only what depends on the rule is redone.
+    rule = newRule;
+    stateVersion++;
+    markAllActive(); // Every cell may behave differently now
+    if (rewind) {
+        rewind->truncateAfter(generation); // The recorded future followed the old rule
+    }
+    return true;
+}
+
+std::vector<PatternSearch::Match> CellularAutomaton::findPattern(const Pattern& pattern, bool isolated) const {
+    return PatternSearch(pattern, isolated).find(grid, width, height);
+}
+
+bool CellularAutomaton::enableTracking(std::ostream& log) {
+    if (!rule.isConway()) return false;
+    tracker.reset(new SpaceshipTracker(log));
+    return true;
+}
+
+void CellularAutomaton::setCell(int x, int y, bool alive) {
+    editCell(x, y, alive);
+    finishEdits();
+}
+
+void CellularAutomaton::editCell(int x, int y, bool alive) {
+    if (x < 0 || x >= width || y < 0 || y >= height) return;
+    size_t index = size_t(y) * width + x;
+    if (grid.test(index) == alive) return;
+
+    grid.set(index, alive);
+    int tx = x >> ChangedTiles::SHIFT, ty = y >> ChangedTiles::SHIFT;
+    markActiveAround(tx, ty);
+    editedTiles->mark(tx, ty);
+    if (rewind) {
+        // grid is always generation `generation` here (run() advances the counter before it pauses), so this drops
+        // the now-stale future and amends the entry on screen.
+        rewind->truncateAfter(generation);
+        rewind->amend(index >> 6, uint64_t(1) << (index & 63));
+    }
+}
+
+void CellularAutomaton::finishEdits() {
+    if (editedTiles->list().empty()) return;
+    stateVersion++;
+    if (pyramid) {
+        pyramid->update(grid, *editedTiles);
+    }
+    if (history) {
+        history->capture(grid, generation, editedTiles.get());
+    }
+    editedTiles->clear();
+}
+
+void CellularAutomaton::toggleCell(int x, int y) {
+    if (x < 0 || x >= width || y < 0 || y >= height) return;
+    setCell(x, y, !grid.test(size_t(y) * width + x));
+}
+
+bool CellularAutomaton::seekGeneration(int target) {
+    if (!rewind || !rewind->seek(grid, generation, target)) return false;
+    generation = target;
+
+    // prevGrid feeds the period-2 check; rebuild it from the buffer when it is still there.
+    prevGrid = grid;
+    if (target > rewind->oldest()) {
+        rewind->seek(prevGrid, target, target - 1);
+    }
+    gridReplaced(false);
+    return true;
+}
+
+void CellularAutomaton::setGenerationsPerFrame(int count) {
+    generationsPerFrame = std::max(1, count);
+}
+
+void CellularAutomaton::setViewport(int x, int y, int zoom) {
+    view.x = x;
+    view.y = y;
+    view.zoom = std::clamp(zoom, 0, DensityPyramid::topLevel(width, height)); // Coarser levels would be blank
+}
+
+void CellularAutomaton::enablePyramid() {
+    if (pyramid) return;
+    pyramid.reset(new DensityPyramid(width, height));
+    pyramid->rebuild(grid);
+}
+
+std::vector<uint64_t> CellularAutomaton::density(int level, int bx, int by, int cols, int rows) {
+    enablePyramid();
+    return pyramid->query(grid, level, bx, by, cols, rows);
+}
+
+void CellularAutomaton::enableHistory(size_t capacity) {
+    history.reset(new SnapshotHistory(width, height, capacity));
+    history->capture(grid, generation, nullptr);
+}
+
+void CellularAutomaton::run(bool displayEnabled) {
+    std::cout << "\033[2J\033[1;1H"; // Clear screen
+
+    auto startTotal = std::chrono::high_resolution_clock::now();
+    int startGeneration = generation;
+    int& iteration = generation;
+    long long lastStepMicros = 0;
+    bool finished = true;
+    FramePacer pacer{std::chrono::milliseconds(speed)};
+    std::unique_ptr<TerminalInput> keys;
+    if (displayEnabled) {
+        keys.reset(new TerminalInput());
+        enablePyramid();
+    }
+
+    if (exporter) {
+        exporter->push(iteration, grid);
+    }
+    if (sharedFrames) {
+        sharedFrames->publish(iteration, grid);
+    }
+    if (server) {
+        server->publish(iteration, grid, 0);
+    }
+
+    while (true) {
+        auto startIter = std::chrono::high_resolution_clock::now();
+        bool isAlive = tick(); // From here on grid and iteration both name the new generation
+        auto endIter = std::chrono::high_resolution_clock::now();
+        Metrics::recordStep(uint64_t(width) * height,
+                            std::chrono::duration_cast<std::chrono::nanoseconds>(endIter - startIter).count());
+
+        bool frame = displayEnabled && (!isAlive || iteration % generationsPerFrame == 0);
+        if (frame) {
+            if (!handleKeys(*keys)) {
+                finished = false;
+                break;
+            }
+            std::cout << "\033[H"; // Move cursor to the top-left
+            display();
+            if (paused && !waitWhilePaused(*keys, iteration - startGeneration, startTotal, lastStepMicros)) {
+                finished = false;
+                break;
+            }
+        }
+
+        if (!isAlive) {
+            std::cout << "Board has reached a stable or alternating state.\n";
+            break;
+        }
+
+        if (exporter) {
+            exporter->push(iteration, grid);
+        }
+        if (sharedFrames) {
+            sharedFrames->publish(iteration, grid);
+        }
+
+        auto iterDuration = std::chrono::duration_cast<std::chrono::microseconds>(endIter - startIter);
+        if (server) {
+            server->publish(iteration, grid, iterDuration.count());
+        }
+        if (frame || !displayEnabled) {
+            std::cout << "Iteration " << iteration << ": " << iterDuration.count() << " microseconds\n";
+        }
+
+        lastStepMicros = iterDuration.count();
+        if (frame) {
+            std::cout << std::flush;
+            pacer.wait();
+        }
+
+        if (serviceSignals(iteration - startGeneration, startTotal, lastStepMicros)) {
+            finished = false;
+            break;
+        }
+    }
+
+    auto endTotal = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double> elapsed = endTotal - startTotal;
+
+    std::cout << "Total time for " << iteration - startGeneration << " iterations: " << elapsed.count() << " seconds\n";
+    if (finished) {
+        Metrics::recordSoupCompleted();
+    }
+    if (tracker) {
+        tracker->summarize();
+    }
+    if (history) {
+        std::cout << "History: " << history->size() << " snapshots sharing " << history->distinctTiles() << " distinct tiles\n";
+    }
+
+    if (heatmap && !heatmapPath.empty() && !heatmap->windowComplete()) { // A complete window is already written
+        writeHeatmap();
+    }
+    if (exporter) {
+        exporter->finish();
+    }
+}
+
+bool CellularAutomaton::serviceSignals(int steps, std::chrono::high_resolution_clock::time_point start,
+                                       long long lastStepMicros) {
+    if (statsRequested) {
+        statsRequested = 0;
+        dumpStats(steps, start, lastStepMicros);
+    }
+    if (!stopRequested) return false;
+    if (saveCheckpoint(checkpointPath)) {
+        std::cerr << "Stopped at generation " << generation << ", checkpoint written to " << checkpointPath << "\n";
+    } else {
+        std::cerr << "Stopped at generation " << generation << ", failed to write checkpoint " << checkpointPath << "\n";
+    }
+    return true;
+}
+
+void CellularAutomaton::dumpStats(int steps, std::chrono::high_resolution_clock::time_point start, long long lastStepMicros) const {
+    double seconds = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+    Metrics::Totals totals = Metrics::totals();
+    std::cerr << "generation=" << generation
+              << " gens_per_s=" << (seconds > 0 ? steps / seconds : 0)
+              << " cells_per_s=" << (seconds > 0 ? double(steps) * width * height / seconds : 0)
+              << " last_step_us=" << lastStepMicros
+              << " p50_s=" << totals.latencyQuantile(0.5)
+              << " p99_s=" << totals.latencyQuantile(0.99) << "\n";
+}
+
+void CellularAutomaton::gridReplaced(bool captureHistory) {
+    stateVersion++;
+    nextGrid = grid;
+    markAllActive();
+    if (ages) {
+        ages->reset(grid);
+    }
+    if (pyramid) {
+        pyramid->rebuild(grid);
+    }
+    if (history && captureHistory) {
+        history->capture(grid, generation, nullptr);
+    }
+    if (rewind && (generation < rewind->oldest() || generation > rewind->newest())) {
+        rewind->record(grid, generation, nullptr);
+    }
+}
+
+void CellularAutomaton::markAllActive() {
+    for (int ty = 0; ty < activeTiles->rows(); ++ty) {
+        for (int tx = 0; tx < activeTiles->columns(); ++tx) {
+            activeTiles->mark(tx, ty);
+        }
+    }
+}
+
+void CellularAutomaton::writeHeatmap() {
+    std::string path = heatmapPath;
+    if (heatmap->windowed()) {
+        size_t dot = path.rfind('.');
+        if (dot == std::string::npos || path.find('/', dot) != std::string::npos) dot = path.size();
+        char number[16];
+        std::snprintf(number, sizeof(number), "_%06d", heatmapWindows++);
+        path.insert(dot, number);
+    }
+    if (!heatmap->writePGM(path)) {
+        std::cerr << "Failed to write heatmap to " << path << "\n";
+    }
+}
+
+void CellularAutomaton::initializeRandom() {
+    SplitMix64 random(initialSeed); // Per board, so concurrent boards neither share nor race on generator state
+    grid = SymmetricSoup::generate(width, height, SymmetricSoup::C1, 0.5, random);
+}
+
+bool CellularAutomaton::update() {
+    computeNext();
+    if (nextGrid == prevGrid || nextGrid == grid) {
+        period = nextGrid == grid ? 1 : 2;
+        return false; // Stable or alternating state detected
+    }
+    period = 0;
+    advance();
+    return true; // Continue simulation
+}
+
+void CellularAutomaton::computeNext() {
+    // A cell can only change if something in its neighborhood changed last generation (or was edited), so only
+    // tiles next to such changes are recomputed. Everywhere else nextGrid already equals grid.
+    for (int tile : activeTiles->list()) {
+        updateTile(tile % activeTiles->columns(), tile / activeTiles->columns());
+    }
+    activeTiles->clear();
+
+    if (heatmap) {
+        // A finished window is cleared only now, so the frame after it completed still displayed it.
+        if (heatmap->windowComplete()) heatmap->clear();
+        heatmap->accumulate(grid, nextGrid);
+        if (heatmap->windowComplete() && !heatmapPath.empty()) writeHeatmap();
+    }
+}
+
+void CellularAutomaton::advance() {
+    changedTiles->compute(grid, nextGrid);
+    for (int tile : changedTiles->list()) {
+        markActiveAround(tile % changedTiles->columns(), tile / changedTiles->columns());
+    }
+
+    prevGrid = grid; // Save the current state to prevGrid
+    grid = nextGrid; // Update the current grid to nextGrid
+    stateVersion++;
+
+    if (pyramid) {
+        pyramid->update(grid, *changedTiles);
+    }
+    if (history) {
+        history->capture(grid, generation + 1, changedTiles.get());
+    }
+    if (tracker) {
+        tracker->update(grid, width, height, *changedTiles, generation + 1);
+    }
+    if (rewind) {
+        rewind->truncateAfter(generation); // Stepping from a rewound state replaces the old future
+        rewind->record(grid, generation + 1, &prevGrid);
+    }
+
+    if (ages) {
+        ages->update(grid);
+    }
+}
+
+void CellularAutomaton::updateTile(int tx, int ty) {
+    int x0 = tx << ChangedTiles::SHIFT, y0 = ty << ChangedTiles::SHIFT;
+    for (int y = y0; y < std::min(height, y0 + ChangedTiles::SIZE); ++y) {
+        for (int x = x0; x < std::min(width, x0 + ChangedTiles::SIZE); ++x) {
+            size_t index = size_t(y) * width + x;
+            int liveNeighbors = countLiveNeighbors(x, y);
+
+            bool alive = grid.test(index); // Use test to read a cell value
+            nextGrid.set(index, rule.next(alive, liveNeighbors)); // Use set to write a cell value
+        }
+    }
+}
+
+void CellularAutomaton::markActiveAround(int tx, int ty) {
+    for (int y = std::max(0, ty - 1); y <= std::min(activeTiles->rows() - 1, ty + 1); ++y) {
+        for (int x = std::max(0, tx - 1); x <= std::min(activeTiles->columns() - 1, tx + 1); ++x) {
+            activeTiles->mark(x, y);
+        }
+    }
+}
+
+int CellularAutomaton::countLiveNeighbors(int x, int y) const {
+    int count = 0;
+
+    for (int dy = -1; dy <= 1; ++dy) {
+        for (int dx = -1; dx <= 1; ++dx) {
+            if (dx == 0 && dy == 0) // Skip the current cell
+                continue;
+
+            int nx = x + dx;
+            int ny = y + dy;
+
+            // Ensure neighbors are within bounds
+            if (nx >= 0 && nx < width && ny >= 0 && ny < height) {
+                count += grid.test(size_t(ny) * width + nx); // Use test to read neighbor's value
+            }
+        }
+    }
+
+    return count;
+}
+
+bool CellularAutomaton::handleKeys(TerminalInput& keys) {
+    bool changed = false;
+    for (int key = keys.poll(); key != TerminalInput::NONE; key = keys.poll()) {
+        int stepX = std::max(1, view.cols / 4) << view.zoom;
+        int stepY = std::max(1, view.rows / 4) << view.zoom;
+        switch (key) {
+            case 'q': case 3: return false;
+            case TerminalInput::LEFT: case 'h': view.x -= stepX; break;
+            case TerminalInput::RIGHT: case 'l': view.x += stepX; break;
+            case TerminalInput::UP: case 'k': view.y -= stepY; break;
+            case TerminalInput::DOWN: case 'j': view.y += stepY; break;
+            case '+': case '=': view.zoom = std::max(0, view.zoom - 1); break;
+            case '-': view.zoom = std::min(pyramid->topLevel(), view.zoom + 1); break;
+            case 'w': view.cursorY -= 1 << view.zoom; break;
+            case 's': view.cursorY += 1 << view.zoom; break;
+            case 'a': view.cursorX -= 1 << view.zoom; break;
+            case 'd': view.cursorX += 1 << view.zoom; break;
+            case 't': toggleCell(view.cursorX, view.cursorY); break;
+            case ' ': paused = !paused; break;
+            case ',': if (paused) seekGeneration(generation - 1); break;
+            case '.':
+                // Replay a recorded generation if there is one, otherwise let the loop advance one frame.
+                if (paused && !seekGeneration(generation + 1)) stepRequested = true;
+                break;
+            default: continue;
+        }
+        changed = true;
+    }
+    if (changed) {
+        std::cout << "\033[2J"; // The view may have shrunk; clear what it no longer covers
+        redrawRequested = true;
+    }
+    return true;
+}
+
+bool CellularAutomaton::waitWhilePaused(TerminalInput& keys, int steps,
+                                        std::chrono::high_resolution_clock::time_point start, long long lastStepMicros) {
+    stepRequested = false;
+    redrawRequested = true;
+    while (paused && !stepRequested) {
+        if (!handleKeys(keys) || serviceSignals(steps, start, lastStepMicros)) return false;
+        if (redrawRequested) {
+            redrawRequested = false;
+            std::cout << "\033[H";
+            display();
+            std::cout << "Paused at generation " << generation << "\033[K\n" << std::flush;
+        } else {
+            std::this_thread::sleep_for(std::chrono::milliseconds(15));
+        }
+    }
+    return true;
+}
+
+void CellularAutomaton::fitViewport() {
+    int block = 1 << view.zoom;
+    int maxCols = (width + block - 1) / block;
+    int maxRows = (height + block - 1) / block;
+
+    winsize ws{};
+    if (isatty(STDOUT_FILENO) && ioctl(STDOUT_FILENO, TIOCGWINSZ, &ws) == 0 && ws.ws_col > 0) {
+        view.cols = std::min<int>(maxCols, ws.ws_col);
+        view.rows = std::min<int>(maxRows, std::max(1, ws.ws_row - 2)); // Status and iteration lines
+    } else {
+        view.cols = maxCols;
+        view.rows = maxRows;
+    }
+    view.x = std::max(0, std::min(view.x, width - view.cols * block)) / block * block;
+    view.y = std::max(0, std::min(view.y, height - view.rows * block)) / block * block;
+    view.cursorX = std::max(view.x, std::min(view.cursorX, std::min(width, view.x + view.cols * block) - 1));
+    view.cursorY = std::max(view.y, std::min(view.cursorY, std::min(height, view.y + view.rows * block) - 1));
+}
+
+void CellularAutomaton::display() {
+    fitViewport();
+    if (heatmap && heatmapDisplay) {
+        heatmap->display(view.x, view.y, view.cols, view.rows);
+        return;
+    }
+    if (view.zoom > 0) {
+        displayZoomed();
+        return;
+    }
+
+    // Newborn cells are bright green, fading through yellow and orange to red as they age.
+    static const int ageColors[CellAges::MAX_AGE + 1] = {
+        82, 82, 118, 154, 190, 226, 220, 214, 208, 202, 196, 160, 124, 125, 126, 127
+    };
+
+    for (int y = view.y; y < view.y + view.rows; ++y) {
+        for (int x = view.x; x < view.x + view.cols; ++x) {
+            if (x == view.cursorX && y == view.cursorY) {
+                std::cout << "\033[7m" << (grid.test(size_t(y) * width + x) ? "◆" : " ") << "\033[0m";
+            } else if (!grid.test(size_t(y) * width + x)) {
+                std::cout << ' ';
+            } else if (ages) {
+                std::cout << "\033[38;5;" << ageColors[ages->at(x, y)] << "m◆\033[0m";
+            } else {
+                std::cout << "\033[38;5;82m◆\033[0m";
+            }
+        }
+        std::cout << '\n';
+    }
+    displayStatus();
+}
+
+void CellularAutomaton::displayZoomed() {
+    static const char* shades[] = {" ", "·", "░", "▒", "▓", "█"};
+    int block = 1 << view.zoom;
+    double area = double(block) * block;
+    std::vector<uint64_t> counts = density(view.zoom, view.x >> view.zoom, view.y >> view.zoom, view.cols, view.rows);
+
+    for (int row = 0; row < view.rows; ++row) {
+        for (int col = 0; col < view.cols; ++col) {
+            uint64_t count = counts[size_t(row) * view.cols + col];
+            int shade = count == 0 ? 0 : 1 + std::min(4, int(count * 4 / area * 2));
+            if (shade == 0) {
+                std::cout << ' ';
+            } else {
+                std::cout << "\033[38;5;82m" << shades[shade] << "\033[0m";
+            }
+        }
+        std::cout << '\n';
+    }
+    displayStatus();
+}
+
+void CellularAutomaton::displayStatus() const {
+    std::cout << "\033[K[" << view.x << ", " << view.y << "] zoom 1:" << (1 << view.zoom)
+              << " of " << width << "x" << height << " cursor (" << view.cursorX << ", " << view.cursorY << ")"
+              << "  (arrows/hjkl pan, +/- zoom, wasd cursor, t toggle, space pause, q quit)\n";
+}
+
+} // namespace gol
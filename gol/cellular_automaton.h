@@ -0,0 +1,268 @@
+/**
+ * Cellular Automaton
+ *
+ * Goals
+ *  - Implement a simple cellular automaton simulation using the Game of Life rules.
+ *  - Use a DynamicBitset class to manage the grid state.
+ *  - Display the grid state in the console.
+ *  - Measure the time taken for each iteration and the total time for the simulation.
+ *  - Allow customization of the board dimensions and speed of the simulation.
+ *  - Allow to run concurrent simulations with different parameters (like percentage of cells alive).
+ *  - Search for stable or oscillating patterns in the grid.
+ * */
+
+#ifndef GOL_CELLULAR_AUTOMATON_H
+#define GOL_CELLULAR_AUTOMATON_H
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "cell_ages.h"
+#include "density_pyramid.h"
+#include "dynamic_bitset.h"
+#include "frame_exporter.h"
+#include "frame_server.h"
+#include "heatmap.h"
+#include "life_rule.h"
+#include "light_cone.h"
+#include "pattern.h"
+#include "rewind_buffer.h"
+#include "seed.h"
+#include "shared_frames.h"
+#include "snapshot_history.h"
+#include "spaceship_tracker.h"
+#include "symmetric_soup.h"
+#include "terminal_input.h"
+#include "tiles.h"
+
+namespace gol {
+
+class CellularAutomaton {
+public:
+    // The initial board is a 50% soup drawn from `seed`; boards built with the same seed start identical.
+    CellularAutomaton(int width, int height, int speed, uint64_t seed);
+
+    // As above, with a seed from std::random_device.
+    CellularAutomaton(int width, int height, int speed);
+
+    // The seed the current board was drawn from (by the constructor or the last randomize()).
+    uint64_t seed() const { return initialSeed; }
+
+    // Track per-cell activity. With a window, each window's heatmap is written to pgmPath with its window number
+    // added (heat.pgm -> heat_000000.pgm, heat_000001.pgm, ...), the last one possibly partial; with window 0 it is
+    // written to pgmPath once, when the run ends. showHeatmap renders it instead of the cells.
+    void enableHeatmap(int window, const std::string& pgmPath, bool showHeatmap);
+
+    // Track how long each cell has been alive and color the display by age.
+    void enableAges();
+
+    // Write every generation as <prefix>_NNNNNN.png/.ppm using a pool of encoder threads.
+    void enableFrameExport(FrameExporter::Format format, const std::string& prefix, int threads);
+
+    // Publish every generation into the POSIX shared-memory segment `name` (e.g. "/gol").
+    bool enableSharedFrames(const std::string& name);
+
+    // Stream frames and stats to clients of the Unix domain socket at `path`.
+    bool enableFrameServer(const std::string& path);
+
+    // On SIGTERM the run stops after the current generation and saves its state to `path`.
+    void setCheckpointPath(const std::string& path);
+
+    // Checkpoint layout: "GOLCKPT1", int32 width, int32 height, int32 generation, then the packed
+    // words of grid and prevGrid (prevGrid is needed to keep detecting period-2 endings after a resume).
+    bool saveCheckpoint(const std::string& path) const;
+
+    bool loadCheckpoint(const std::string& path);
+
+    // Keep the last `capacity` generations for interactive rewind, with a keyframe every keyframeInterval.
+    void enableRewind(size_t capacity, int keyframeInterval = 64);
+
+    // State of the w x h rectangle at (x, y), `generations` steps after the current board (row-major, w * h cells).
+    // Only the light cone of the rectangle is simulated, and intermediate tiles are cached until the board changes.
+    // The light cone steps B3/S23 only: returns false, leaving out untouched, under any other rule.
+    bool regionAt(int x, int y, int w, int h, int generations, DynamicBitset& out);
+
+    int boardWidth() const { return width; }
+    int boardHeight() const { return height; }
+    int currentGeneration() const { return generation; }
+
+    // Advance exactly `generations` generations, without the stable/period-2 stop that run() applies.
+    void step(int generations);
+
+    // Advance one generation, unless the board has become stable or alternates with period 2 (the state where run()
+    // stops). Returns false, without advancing, once that happens.
+    bool tick();
+
+    // 1 (stable) or 2 (alternating) once tick() or run() has stopped on that, 0 while the board is still evolving.
+    int settledPeriod() const { return period; }
+
+    uint64_t population() const;
+
+    // Hash of the board contents and dimensions.
+    uint64_t hash() const;
+
+    // Copy of the w x h rectangle at (x, y), row-major. Cells off the board read as dead.
+    DynamicBitset region(int x, int y, int w, int h) const;
+
+    // Overwrite the w x h rectangle at (x, y) from a row-major bitset, as a batch of cell edits.
+    void setRegion(int x, int y, int w, int h, const DynamicBitset& cells);
+
+    // Kill every cell.
+    void clear();
+
+    // Replace the board with a random soup with the given symmetry, each cell of its fundamental domain alive with
+    // probability `density`, drawn from a generator seeded with seed. C4 and D8 need a square board.
+    void randomize(uint64_t seed, double density, SymmetricSoup::Symmetry symmetry = SymmetricSoup::C1);
+
+    // Copy the live cells of pattern onto the board with its top-left corner at (x, y).
+    void placePattern(const Pattern& pattern, int x, int y);
+
+    // Step with this rule instead of B3/S23. Returns false, keeping the current rule, if spaceship tracking is on and
+    // the rule is not B3/S23; regionAt() refuses other rules when it is called.
+    bool setRule(const LifeRule& rule);
+    const LifeRule& currentRule() const { return rule; }
+
+    // The current board, packed row-major (cell (x, y) is bit y * width + x). The buffer stays at the same address for
+    // the automaton's lifetime; its contents change with every step or edit.
+    const DynamicBitset& cells() const { return grid; }
+
+    // All placements of pattern (in every orientation) in the current board.
+    std::vector<PatternSearch::Match> findPattern(const Pattern& pattern, bool isolated) const;
+
+    // Follow spaceships every generation and log collisions (and a track summary when the run ends) to `log`.
+    // The tracker recognizes B3/S23 spaceships only, so this returns false under any other rule.
+    bool enableTracking(std::ostream& log);
+
+    // Set a single cell mid-run. Only the tiles around it are marked for recomputation; the rest of the board
+    // keeps skipping work as before.
+    void setCell(int x, int y, bool alive);
+
+    void toggleCell(int x, int y);
+
+    // Jump to a recorded generation. Returns false if it is no longer (or not yet) in the rewind buffer.
+    bool seekGeneration(int target);
+
+    // Advance this many generations between displayed frames; speed stays the frame period.
+    void setGenerationsPerFrame(int count);
+
+    // Top-left board cell of the displayed region and its zoom level (each character covers 2^zoom x 2^zoom cells).
+    void setViewport(int x, int y, int zoom);
+
+    // Maintain the density pyramid used for zoomed-out views and density queries.
+    void enablePyramid();
+
+    // Live-cell counts of cols x rows blocks of 2^level cells square, starting at block (bx, by).
+    std::vector<uint64_t> density(int level, int bx, int by, int cols, int rows);
+
+    // Keep copy-on-write snapshots of the last `capacity` generations.
+    void enableHistory(size_t capacity);
+
+    void run(bool displayEnabled);
+
+private:
+    int width, height, speed;
+    uint64_t initialSeed;
+    LifeRule rule;
+    DynamicBitset grid;
+    DynamicBitset nextGrid;
+    DynamicBitset prevGrid;
+    std::unique_ptr<ActivityHeatmap> heatmap;
+    std::string heatmapPath;
+    int heatmapWindows = 0; // Windowed heatmaps written so far
+    bool heatmapDisplay = false;
+    std::unique_ptr<ChangedTiles> changedTiles; // Tiles that changed in the last generation
+    std::unique_ptr<ChangedTiles> activeTiles;  // Tiles that can change in the next one
+    std::unique_ptr<ChangedTiles> editedTiles;  // Tiles touched by the edit batch in progress
+    std::unique_ptr<DensityPyramid> pyramid;
+    std::unique_ptr<SnapshotHistory> history;
+    std::unique_ptr<RewindBuffer> rewind;
+    std::unique_ptr<LightCone> lightCone;
+    std::unique_ptr<SpaceshipTracker> tracker;
+    uint64_t stateVersion = 0; // Bumped whenever grid changes
+    bool paused = false;
+    bool stepRequested = false;
+    bool redrawRequested = false;
+    int generation = 0;
+    int period = 0;
+    int generationsPerFrame = 1;
+    std::string checkpointPath = "gol.ckpt";
+
+    // Displayed region: cols x rows characters starting at board cell (x, y), each covering 2^zoom cells square.
+    // The edit cursor is a board cell kept inside the region.
+    struct Viewport {
+        int x = 0, y = 0, zoom = 0;
+        int cols = 0, rows = 0;
+        int cursorX = 0, cursorY = 0;
+    } view;
+    std::unique_ptr<CellAges> ages;
+    std::unique_ptr<FrameExporter> exporter;
+    std::unique_ptr<SharedFramePublisher> sharedFrames;
+    std::unique_ptr<FrameServer> server;
+
+    void dumpStats(int steps, std::chrono::high_resolution_clock::time_point start, long long lastStepMicros) const;
+
+    // Act on SIGUSR1 (dump stats) and SIGTERM (write the checkpoint). Returns true if the run should stop.
+    bool serviceSignals(int steps, std::chrono::high_resolution_clock::time_point start, long long lastStepMicros);
+
+    // The grid was overwritten outside of update(): resync everything derived from it. Ages restart, since the old
+    // ones describe a different board. A seek passes captureHistory = false: it returns to a generation the history
+    // already holds, and capturing it again would file rewound duplicates out of order.
+    void gridReplaced(bool captureHistory = true);
+
+    // Every tile may change in the next generation.
+    void markAllActive();
+
+    // Set one on-board cell as part of an edit batch: marks its tiles and amends the rewind buffer. The pyramid and
+    // history are brought up to date once per batch by finishEdits().
+    void editCell(int x, int y, bool alive);
+    void finishEdits();
+
+    void writeHeatmap();
+
+    void initializeRandom();
+
+    // TODO: Detect oscillating patterns of periods greater than one. 
+    //       Since I am using the DnyamicBitset class, I can create many copies of the grid state without worrying about memory overhead.
+    bool update();
+
+    void computeNext();
+
+    // Make nextGrid the current generation and update everything derived from it.
+    void advance();
+
+    void updateTile(int tx, int ty);
+
+    void markActiveAround(int tx, int ty);
+
+    int countLiveNeighbors(int x, int y) const;
+
+    // Apply pending keys. Returns false when the user asked to quit.
+    //   arrows / hjkl: pan by a quarter of the view    + / -: zoom in / out    q, Ctrl-C: quit
+    //   space: pause / resume    , / .: step back / forward while paused (needs -rewind)
+    //   wasd: move the edit cursor    t: toggle the cell under the cursor
+    bool handleKeys(TerminalInput& keys);
+
+    // Poll keys and signals and redraw until resumed or a single step is requested. Returns false on quit or SIGTERM;
+    // the stats arguments are passed through to serviceSignals().
+    bool waitWhilePaused(TerminalInput& keys, int steps, std::chrono::high_resolution_clock::time_point start,
+                         long long lastStepMicros);
+
+    // Fit the viewport to the terminal (or the whole board when not on a terminal) and keep it on the board.
+    void fitViewport();
+
+    // Renders only the viewport, so the cost follows the terminal size rather than the board size.
+    void display();
+
+    // One character per block, shaded by the fraction of live cells in it.
+    void displayZoomed();
+
+    void displayStatus() const;
+};
+
+} // namespace gol
+
+#endif // GOL_CELLULAR_AUTOMATON_H
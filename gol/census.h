@@ -0,0 +1,108 @@
+#ifndef GOL_CENSUS_H
+#define GOL_CENSUS_H
+
+#include <array>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "dynamic_bitset.h"
+#include "pattern.h"
+
+namespace gol {
+
+// Counts the common objects in a settled board. Each 8-connected group of live cells is compared, in every phase
+// and orientation, against a short list of known objects; anything else (including objects close enough to touch)
+// counts as OTHER.
+class Census {
+public:
+    enum Kind { BLOCK, BLINKER, BEEHIVE, LOAF, BOAT, TUB, POND, SHIP, GLIDER, OTHER, KINDS };
+
+    using Counts = std::array<uint32_t, KINDS>;
+
+    static const char* name(int kind) {
+        static const char* const names[KINDS] = {"block", "blinker", "beehive", "loaf", "boat", "tub", "pond", "ship",
+                                                 "glider", "other"};
+        return names[kind];
+    }
+
+    static Counts take(const DynamicBitset& grid, int width, int height) {
+        Counts counts{};
+        std::vector<uint8_t> seen(size_t(width) * height, 0);
+        std::vector<std::pair<int, int>> stack, cells;
+        for (int y = 0; y < height; ++y) {
+            for (int x = 0; x < width; ++x) {
+                size_t index = size_t(y) * width + x;
+                if (seen[index] || !grid.test(index)) continue;
+
+                // Flood fill one object.
+                cells.clear();
+                stack.assign(1, {x, y});
+                seen[index] = 1;
+                int x0 = x, y0 = y, x1 = x, y1 = y;
+                while (!stack.empty()) {
+                    auto [cx, cy] = stack.back();
+                    stack.pop_back();
+                    cells.push_back({cx, cy});
+                    x0 = std::min(x0, cx), x1 = std::max(x1, cx), y0 = std::min(y0, cy), y1 = std::max(y1, cy);
+                    for (int dy = -1; dy <= 1; ++dy) {
+                        for (int dx = -1; dx <= 1; ++dx) {
+                            int nx = cx + dx, ny = cy + dy;
+                            if (nx < 0 || ny < 0 || nx >= width || ny >= height) continue;
+                            size_t n = size_t(ny) * width + nx;
+                            if (!seen[n] && grid.test(n)) {
+                                seen[n] = 1;
+                                stack.push_back({nx, ny});
+                            }
+                        }
+                    }
+                }
+                counts[classify(cells, x0, y0, x1, y1)]++;
+            }
+        }
+        return counts;
+    }
+
+private:
+    static Kind classify(const std::vector<std::pair<int, int>>& cells, int x0, int y0, int x1, int y1) {
+        if (x1 - x0 >= 8 || y1 - y0 >= 8) return OTHER; // Bigger than anything in the table
+        Pattern p;
+        p.width = x1 - x0 + 1;
+        p.height = y1 - y0 + 1;
+        p.rows.assign(p.height, 0);
+        for (auto [cx, cy] : cells) p.rows[cy - y0] |= uint64_t(1) << (cx - x0);
+
+        for (const auto& known : table()) {
+            if (known.first == p) return known.second;
+        }
+        return OTHER;
+    }
+
+    // Every phase and orientation of each known object.
+    static const std::vector<std::pair<Pattern, Kind>>& table() {
+        static const std::vector<std::pair<Pattern, Kind>> entries = [] {
+            const std::pair<const char*, Kind> objects[] = {
+                {"OO\nOO", BLOCK},        {"OOO", BLINKER},           {".OO.\nO..O\n.OO.", BEEHIVE},
+                {".OO.\nO..O\n.O.O\n..O.", LOAF}, {"OO.\nO.O\n.O.", BOAT}, {".O.\nO.O\n.O.", TUB},
+                {".OO.\nO..O\nO..O\n.OO.", POND}, {"OO.\nO.O\n.OO", SHIP}, {".O.\n..O\nOOO", GLIDER},
+            };
+            std::vector<std::pair<Pattern, Kind>> out;
+            for (const auto& object : objects) {
+                Pattern phase;
+                Pattern::parse(object.first, phase);
+                for (int step = 0; step < 4; ++step) {
+                    for (int symmetry = 0; symmetry < 8; ++symmetry) {
+                        out.push_back({phase.transformed(symmetry), object.second});
+                    }
+                    phase = phase.stepped();
+                }
+            }
+            return out;
+        }();
+        return entries;
+    }
+};
+
+} // namespace gol
+
+#endif // GOL_CENSUS_H
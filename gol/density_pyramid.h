@@ -0,0 +1,132 @@
+#ifndef GOL_DENSITY_PYRAMID_H
+#define GOL_DENSITY_PYRAMID_H
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "dynamic_bitset.h"
+#include "tiles.h"
+
+namespace gol {
+
+// Mipmap-style population pyramid: level k holds the live-cell count of every 2^k x 2^k block.
+// Levels from the tile size up are stored and refreshed each generation only where tiles changed;
+// finer levels are counted straight from the grid, which is at most 32 popcounts per block.
+// Either way a query costs O(blocks returned), independent of the board size.
+class DensityPyramid {
+public:
+    DensityPyramid(int width, int height) : width(width), height(height) {
+        int w = (width + ChangedTiles::SIZE - 1) >> ChangedTiles::SHIFT;
+        int h = (height + ChangedTiles::SIZE - 1) >> ChangedTiles::SHIFT;
+        while (true) {
+            levels.push_back(Level{w, h, std::vector<uint64_t>(size_t(w) * h, 0)});
+            if (w == 1 && h == 1) break;
+            w = (w + 1) / 2;
+            h = (h + 1) / 2;
+        }
+    }
+
+    int topLevel() const { return ChangedTiles::SHIFT + int(levels.size()) - 1; }
+
+    // topLevel() of a width x height pyramid, without building one: the level whose single block covers the board.
+    static int topLevel(int width, int height) {
+        int w = (width + ChangedTiles::SIZE - 1) >> ChangedTiles::SHIFT;
+        int h = (height + ChangedTiles::SIZE - 1) >> ChangedTiles::SHIFT;
+        int level = ChangedTiles::SHIFT;
+        for (; w > 1 || h > 1; ++level) {
+            w = (w + 1) / 2;
+            h = (h + 1) / 2;
+        }
+        return level;
+    }
+
+    void rebuild(const DynamicBitset& grid) {
+        Level& base = levels[0];
+        for (int ty = 0; ty < base.h; ++ty) {
+            for (int tx = 0; tx < base.w; ++tx) {
+                base.counts[size_t(ty) * base.w + tx] = countBlock(grid, tx << ChangedTiles::SHIFT, ty << ChangedTiles::SHIFT, ChangedTiles::SIZE);
+            }
+        }
+        for (size_t l = 1; l < levels.size(); ++l) {
+            for (int y = 0; y < levels[l].h; ++y) {
+                for (int x = 0; x < levels[l].w; ++x) {
+                    refresh(l, x, y);
+                }
+            }
+        }
+    }
+
+    // Recount the changed tiles and propagate only along their ancestors.
+    void update(const DynamicBitset& grid, const ChangedTiles& changed) {
+        std::vector<int> nodes;
+        for (int tile : changed.list()) {
+            int tx = tile % changed.columns(), ty = tile / changed.columns();
+            levels[0].counts[tile] = countBlock(grid, tx << ChangedTiles::SHIFT, ty << ChangedTiles::SHIFT, ChangedTiles::SIZE);
+            nodes.push_back(tile);
+        }
+        for (size_t l = 1; l < levels.size() && !nodes.empty(); ++l) {
+            int childWidth = levels[l - 1].w;
+            for (int& node : nodes) {
+                node = (node / childWidth / 2) * levels[l].w + (node % childWidth) / 2;
+            }
+            std::sort(nodes.begin(), nodes.end());
+            nodes.erase(std::unique(nodes.begin(), nodes.end()), nodes.end());
+            for (int node : nodes) {
+                refresh(l, node % levels[l].w, node / levels[l].w);
+            }
+        }
+    }
+
+    // Counts of cols x rows blocks of level k starting at block (bx, by), row-major. Blocks off the board count 0.
+    std::vector<uint64_t> query(const DynamicBitset& grid, int level, int bx, int by, int cols, int rows) const {
+        std::vector<uint64_t> out(size_t(cols) * rows, 0);
+        for (int row = 0; row < rows; ++row) {
+            for (int col = 0; col < cols; ++col) {
+                int x = bx + col, y = by + row;
+                if (x < 0 || y < 0) continue;
+                if (level < ChangedTiles::SHIFT) {
+                    out[size_t(row) * cols + col] = countBlock(grid, x << level, y << level, 1 << level);
+                } else if (level - ChangedTiles::SHIFT < int(levels.size())) {
+                    const Level& l = levels[level - ChangedTiles::SHIFT];
+                    if (x < l.w && y < l.h) out[size_t(row) * cols + col] = l.counts[size_t(y) * l.w + x];
+                }
+            }
+        }
+        return out;
+    }
+
+private:
+    struct Level {
+        int w, h;
+        std::vector<uint64_t> counts;
+    };
+
+    int width, height;
+    std::vector<Level> levels; // levels[i] is block size 2^(SHIFT + i)
+
+    void refresh(size_t l, int x, int y) {
+        const Level& child = levels[l - 1];
+        uint64_t sum = 0;
+        for (int cy = 2 * y; cy < std::min(child.h, 2 * y + 2); ++cy) {
+            for (int cx = 2 * x; cx < std::min(child.w, 2 * x + 2); ++cx) {
+                sum += child.counts[size_t(cy) * child.w + cx];
+            }
+        }
+        levels[l].counts[size_t(y) * levels[l].w + x] = sum;
+    }
+
+    uint64_t countBlock(const DynamicBitset& grid, int x, int y, int size) const {
+        if (x >= width || y >= height) return 0;
+        int span = std::min(size, width - x);
+        uint64_t count = 0;
+        for (int row = y; row < std::min(height, y + size); ++row) {
+            count += __builtin_popcountll(grid.bits(size_t(row) * width + x, span));
+        }
+        return count;
+    }
+};
+
+} // namespace gol
+
+#endif // GOL_DENSITY_PYRAMID_H
@@ -0,0 +1,117 @@
+#ifndef GOL_DYNAMIC_BITSET_H
+#define GOL_DYNAMIC_BITSET_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace gol {
+
+// A DynamicBitset class that allows for dynamic allocation of bits on the heap and provides a safe interface for reading and writing bit values. 
+// Bits are packed 64 to a word, so whole-word operations (XOR of two generations, popcounts, ...) can touch 64 cells at once.
+class DynamicBitset {
+public:
+    DynamicBitset(size_t size) : size(size), wordCount((size + 63) / 64), data(new uint64_t[wordCount]()) {}
+
+    DynamicBitset(const DynamicBitset& other) : size(other.size), wordCount(other.wordCount), data(new uint64_t[other.wordCount]) {
+        std::memcpy(data, other.data, wordCount * sizeof(uint64_t));
+    }
+
+    DynamicBitset& operator=(const DynamicBitset& other) {
+        if (this == &other) return *this; // Handle self-assignment
+
+        if (wordCount != other.wordCount) {
+            delete[] data; // Free existing memory
+            data = new uint64_t[other.wordCount];
+        }
+        size = other.size;
+        wordCount = other.wordCount;
+        std::memcpy(data, other.data, wordCount * sizeof(uint64_t));
+        return *this;
+    }
+
+    ~DynamicBitset() {
+        delete[] data; // Properly delete allocated memory
+    }
+
+    bool test(size_t index) const {
+        // Safely read the value of a specific bit
+        if (index < size) {
+            return (data[index >> 6] >> (index & 63)) & 1;
+        }
+        return false;
+    }
+
+    void set(size_t index, bool value) {
+        // Safely set the value of a specific bit
+        if (index < size) {
+            uint64_t mask = uint64_t(1) << (index & 63);
+            data[index >> 6] = value ? (data[index >> 6] | mask) : (data[index >> 6] & ~mask);
+        }
+    }
+
+    void reset() {
+        // Reset all bits to 0
+        std::memset(data, 0, wordCount * sizeof(uint64_t));
+    }
+
+    bool operator==(const DynamicBitset& other) const {
+        // Compare two DynamicBitset objects
+        if (size != other.size) return false;
+        return std::memcmp(data, other.data, wordCount * sizeof(uint64_t)) == 0;
+    }
+
+    // 64-bit hash of the contents (splitmix64-style mixing of each word).
+    uint64_t hash() const {
+        uint64_t h = size * 0x9E3779B97F4A7C15ULL;
+        for (size_t i = 0; i < wordCount; ++i) {
+            uint64_t z = data[i] + 0x9E3779B97F4A7C15ULL * (i + 1);
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+            h = (h ^ (z ^ (z >> 31))) * 0x100000001B3ULL;
+        }
+        return h;
+    }
+
+    // Raw word access for word-parallel passes. Bits past size in the last word are always 0.
+    size_t words() const { return wordCount; }
+    const uint64_t* wordData() const { return data; }
+    uint64_t* wordData() { return data; }
+
+    // Read count (<= 64) consecutive bits starting at pos, which need not be word aligned. Bits past the end read as 0.
+    uint64_t bits(size_t pos, int count) const {
+        if (count <= 0 || pos >= size) return 0;
+        size_t w = pos >> 6;
+        int offset = pos & 63;
+        uint64_t value = data[w] >> offset;
+        if (offset != 0 && w + 1 < wordCount) {
+            value |= data[w + 1] << (64 - offset);
+        }
+        return count < 64 ? value & ((uint64_t(1) << count) - 1) : value;
+    }
+
+    // Overwrite count (<= 64) consecutive bits starting at pos with the low bits of value. Bits past the end are ignored.
+    void setBits(size_t pos, int count, uint64_t value) {
+        if (count <= 0 || pos >= size) return;
+        count = int(std::min<size_t>(count, size - pos));
+        uint64_t mask = count < 64 ? (uint64_t(1) << count) - 1 : ~uint64_t(0);
+        value &= mask;
+
+        size_t w = pos >> 6;
+        int offset = pos & 63;
+        data[w] = (data[w] & ~(mask << offset)) | (value << offset);
+        if (offset + count > 64) {
+            data[w + 1] = (data[w + 1] & ~(mask >> (64 - offset))) | (value >> (64 - offset));
+        }
+    }
+
+private:
+    size_t size;
+    size_t wordCount;
+    uint64_t* data;
+};
+
+} // namespace gol
+
+#endif // GOL_DYNAMIC_BITSET_H
@@ -0,0 +1,100 @@
+#include "engine.h"
+
+#include <chrono>
+
+#include "cellular_automaton.h"
+#include "policy_engine.h"
+
+namespace gol {
+
+namespace {
+
+// The tile-skipping CellularAutomaton behind the Engine interface.
+class DefaultEngine : public Engine {
+public:
+    DefaultEngine(int width, int height) : automaton(width, height, 0, 0) {
+        automaton.clear();
+    }
+
+    std::string name() const override { return "default"; }
+    int width() const override { return automaton.boardWidth(); }
+    int height() const override { return automaton.boardHeight(); }
+
+    void step(int generations) override {
+        auto start = std::chrono::steady_clock::now();
+        automaton.step(generations);
+        stepCalls++;
+        stepMicros += std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - start).count();
+    }
+
+    DynamicBitset getRegion(int x, int y, int w, int h) const override {
+        return automaton.region(x, y, w, h);
+    }
+
+    void setRegion(int x, int y, int w, int h, const DynamicBitset& cells) override {
+        automaton.setRegion(x, y, w, h, cells);
+    }
+
+    EngineStats stats() const override {
+        EngineStats s;
+        s.generation = automaton.currentGeneration();
+        s.population = automaton.population();
+        s.stepCalls = stepCalls;
+        s.stepMicros = stepMicros;
+        return s;
+    }
+
+    uint64_t hash() const override { return automaton.hash(); }
+
+    CellBuffer cellBuffer() const override {
+        const DynamicBitset& cells = automaton.cells();
+        return CellBuffer{cells.wordData(), cells.words(), size_t(automaton.boardWidth())};
+    }
+
+private:
+    CellularAutomaton automaton;
+    uint64_t stepCalls = 0;
+    uint64_t stepMicros = 0;
+};
+
+} // namespace
+
+// Built-ins are added here rather than by static registrar objects, which the linker drops when
+// nothing references their translation unit in libgol.a.
+EngineRegistry::EngineRegistry() {
+    add("default", [](int width, int height) {
+        return std::unique_ptr<Engine>(new DefaultEngine(width, height));
+    });
+    registerPolicyEngine<RowBitStorage, ConwayRule, DeadBoundary, MooreNeighborhood>(*this);
+    registerPolicyEngine<RowBitStorage, ConwayRule, TorusBoundary, MooreNeighborhood>(*this);
+    registerPolicyEngine<RowBitStorage, HighLifeRule, DeadBoundary, MooreNeighborhood>(*this);
+    registerPolicyEngine<RowBitStorage, HighLifeRule, TorusBoundary, MooreNeighborhood>(*this);
+    registerPolicyEngine<ByteStorage, ConwayRule, DeadBoundary, MooreNeighborhood>(*this);
+    registerPolicyEngine<ByteStorage, ConwayRule, TorusBoundary, MooreNeighborhood>(*this);
+}
+
+EngineRegistry& EngineRegistry::instance() {
+    static EngineRegistry registry;
+    return registry;
+}
+
+bool EngineRegistry::add(const std::string& name, Factory factory) {
+    return factories.emplace(name, std::move(factory)).second;
+}
+
+std::unique_ptr<Engine> EngineRegistry::create(const std::string& name, int width, int height) const {
+    auto it = factories.find(name);
+    if (it == factories.end())
+        return nullptr;
+    return it->second(width, height);
+}
+
+std::vector<std::string> EngineRegistry::names() const {
+    std::vector<std::string> result;
+    for (const auto& entry : factories)
+        result.push_back(entry.first);
+    return result;
+}
+
+} // namespace gol
@@ -0,0 +1,88 @@
+#ifndef GOL_ENGINE_H
+#define GOL_ENGINE_H
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "dynamic_bitset.h"
+
+namespace gol {
+
+struct EngineStats {
+    uint64_t generation = 0;
+    uint64_t population = 0;
+    uint64_t stepCalls = 0;
+    uint64_t stepMicros = 0; // Wall time spent inside step(), summed over all calls
+};
+
+// Read-only view of an engine's own cell storage. Cell (x, y) is bit y * strideBits + x of words, counting from the
+// least significant bit of words[0]. strideBits is the width for a packed board, or rowWords * 64 when every row
+// starts on a word boundary. words is nullptr if the engine keeps its cells some other way.
+struct CellBuffer {
+    const uint64_t* words = nullptr;
+    size_t wordCount = 0;
+    size_t strideBits = 0;
+
+    bool test(int x, int y) const {
+        size_t index = size_t(y) * strideBits + x;
+        return (words[index >> 6] >> (index & 63)) & 1;
+    }
+};
+
+// What a simulation backend has to provide to be driven by the library's front ends. Boards are fixed-size and
+// start empty; cells are exchanged as row-major bitsets, so an engine is free to store them however it likes.
+class Engine {
+public:
+    virtual ~Engine() {}
+
+    virtual std::string name() const = 0;
+    virtual int width() const = 0;
+    virtual int height() const = 0;
+
+    // Advance exactly `generations` generations.
+    virtual void step(int generations) = 0;
+
+    // Copy of the w x h rectangle at (x, y), row-major. Cells off the board read as dead.
+    virtual DynamicBitset getRegion(int x, int y, int w, int h) const = 0;
+
+    // Overwrite the w x h rectangle at (x, y) from a row-major bitset. Cells off the board are ignored.
+    virtual void setRegion(int x, int y, int w, int h, const DynamicBitset& cells) = 0;
+
+    virtual EngineStats stats() const = 0;
+
+    // Hash of the board contents and dimensions. Engines running the same rule on the same board agree on it.
+    virtual uint64_t hash() const = 0;
+
+    // The engine's cells in place, for engines that keep one bit per cell; an empty buffer otherwise, and callers fall
+    // back to getRegion(). Engines may double-buffer, so the view is only valid until the next step or edit.
+    virtual CellBuffer cellBuffer() const { return CellBuffer(); }
+};
+
+// Engines by name. The built-in ones are registered up front; others can be added with add() before use.
+class EngineRegistry {
+public:
+    using Factory = std::function<std::unique_ptr<Engine>(int width, int height)>;
+
+    static EngineRegistry& instance();
+
+    // Returns false (and keeps the existing factory) if the name is already taken.
+    bool add(const std::string& name, Factory factory);
+
+    // nullptr if no engine has that name.
+    std::unique_ptr<Engine> create(const std::string& name, int width, int height) const;
+
+    std::vector<std::string> names() const;
+
+private:
+    EngineRegistry();
+
+    std::map<std::string, Factory> factories;
+};
+
+} // namespace gol
+
+#endif // GOL_ENGINE_H
@@ -0,0 +1,208 @@
+#ifndef GOL_FRAME_EXPORTER_H
+#define GOL_FRAME_EXPORTER_H
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "dynamic_bitset.h"
+
+namespace gol {
+
+// Writes generations as numbered PNG or PPM images on a pool of worker threads.
+// The simulation only copies the packed grid into a bounded queue; encoding and file I/O happen off the step loop.
+// When every worker is busy and the queue is full, push() waits, so no frame is ever dropped.
+class FrameExporter {
+public:
+    enum Format { PNG, PPM };
+
+    FrameExporter(int width, int height, Format format, const std::string& prefix, int threads, size_t queueDepth = 8)
+        : width(width), height(height), format(format), prefix(prefix), queueDepth(queueDepth) {
+        for (uint32_t n = 0; n < 256; ++n) {
+            uint32_t c = n;
+            for (int k = 0; k < 8; ++k) {
+                c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            }
+            crcTable[n] = c;
+        }
+        for (int i = 0; i < std::max(threads, 1); ++i) {
+            workers.emplace_back(&FrameExporter::workerLoop, this);
+        }
+    }
+
+    ~FrameExporter() {
+        finish();
+    }
+
+    void push(int generation, const DynamicBitset& grid) {
+        Frame frame{generation, std::vector<uint64_t>(grid.wordData(), grid.wordData() + grid.words())};
+
+        std::unique_lock<std::mutex> lock(mutex);
+        notFull.wait(lock, [this] { return queue.size() < queueDepth; });
+        queue.push_back(std::move(frame));
+        notEmpty.notify_one();
+    }
+
+    // Drain the queue and join the workers.
+    void finish() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (stopping) return;
+            stopping = true;
+        }
+        notEmpty.notify_all();
+        for (std::thread& worker : workers) {
+            worker.join();
+        }
+    }
+
+private:
+    struct Frame {
+        int generation;
+        std::vector<uint64_t> cells;
+    };
+
+    int width, height;
+    Format format;
+    std::string prefix;
+    size_t queueDepth;
+    std::deque<Frame> queue;
+    std::mutex mutex;
+    std::condition_variable notEmpty, notFull;
+    bool stopping = false;
+    std::vector<std::thread> workers;
+    uint32_t crcTable[256];
+
+    void workerLoop() {
+        while (true) {
+            Frame frame;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                notEmpty.wait(lock, [this] { return stopping || !queue.empty(); });
+                if (queue.empty()) return; // Stopping and drained
+                frame = std::move(queue.front());
+                queue.pop_front();
+                notFull.notify_one();
+            }
+            write(frame);
+        }
+    }
+
+    bool cell(const Frame& frame, size_t index) const {
+        return (frame.cells[index >> 6] >> (index & 63)) & 1;
+    }
+
+    void write(const Frame& frame) {
+        char name[32];
+        std::snprintf(name, sizeof(name), "_%06d.%s", frame.generation, format == PNG ? "png" : "ppm");
+        std::string path = prefix + name;
+
+        std::ofstream out(path, std::ios::binary);
+        if (!out) {
+            std::cerr << "Failed to write frame " << path << "\n";
+            return;
+        }
+
+        if (format == PPM) {
+            // Same green-on-black as the console display.
+            out << "P6\n" << width << ' ' << height << "\n255\n";
+            std::vector<uint8_t> row(size_t(width) * 3);
+            for (int y = 0; y < height; ++y) {
+                for (int x = 0; x < width; ++x) {
+                    bool alive = cell(frame, size_t(y) * width + x);
+                    row[x * 3 + 0] = alive ? 0x5F : 0;
+                    row[x * 3 + 1] = alive ? 0xFF : 0;
+                    row[x * 3 + 2] = 0;
+                }
+                out.write(reinterpret_cast<const char*>(row.data()), row.size());
+            }
+            return;
+        }
+
+        // 1-bit grayscale PNG: each scanline is a filter byte (0) followed by MSB-first packed pixels.
+        size_t stride = (size_t(width) + 7) / 8 + 1;
+        std::vector<uint8_t> raw(stride * height, 0);
+        for (int y = 0; y < height; ++y) {
+            uint8_t* line = &raw[y * stride + 1];
+            for (int x = 0; x < width; ++x) {
+                if (cell(frame, size_t(y) * width + x)) {
+                    line[x >> 3] |= 0x80 >> (x & 7);
+                }
+            }
+        }
+
+        std::vector<uint8_t> header;
+        appendBE32(header, width);
+        appendBE32(header, height);
+        header.insert(header.end(), {1, 0, 0, 0, 0}); // Bit depth 1, grayscale, deflate, no filter, no interlace
+
+        out.write("\x89PNG\r\n\x1a\n", 8);
+        writeChunk(out, "IHDR", header);
+        writeChunk(out, "IDAT", zlibStore(raw));
+        writeChunk(out, "IEND", {});
+    }
+
+    // zlib stream made of uncompressed (stored) deflate blocks.
+    static std::vector<uint8_t> zlibStore(const std::vector<uint8_t>& data) {
+        std::vector<uint8_t> out = {0x78, 0x01};
+        size_t pos = 0;
+        do {
+            size_t len = std::min<size_t>(data.size() - pos, 65535);
+            bool last = pos + len == data.size();
+            out.push_back(last ? 1 : 0);
+            out.push_back(len & 0xFF);
+            out.push_back(len >> 8);
+            out.push_back(~len & 0xFF);
+            out.push_back((~len >> 8) & 0xFF);
+            out.insert(out.end(), data.begin() + pos, data.begin() + pos + len);
+            pos += len;
+        } while (pos < data.size());
+
+        uint32_t a = 1, b = 0;
+        for (size_t i = 0; i < data.size(); ) {
+            // Defer the modulo for as long as the sums cannot overflow.
+            size_t end = std::min(data.size(), i + 5552);
+            for (; i < end; ++i) {
+                a += data[i];
+                b += a;
+            }
+            a %= 65521;
+            b %= 65521;
+        }
+        appendBE32(out, (b << 16) | a);
+        return out;
+    }
+
+    void writeChunk(std::ofstream& out, const char* type, const std::vector<uint8_t>& payload) const {
+        std::vector<uint8_t> chunk;
+        appendBE32(chunk, payload.size());
+        chunk.insert(chunk.end(), type, type + 4);
+        chunk.insert(chunk.end(), payload.begin(), payload.end());
+
+        uint32_t crc = 0xFFFFFFFFu;
+        for (size_t i = 4; i < chunk.size(); ++i) {
+            crc = crcTable[(crc ^ chunk[i]) & 0xFF] ^ (crc >> 8);
+        }
+        appendBE32(chunk, crc ^ 0xFFFFFFFFu);
+        out.write(reinterpret_cast<const char*>(chunk.data()), chunk.size());
+    }
+
+    static void appendBE32(std::vector<uint8_t>& out, uint32_t value) {
+        out.push_back(value >> 24);
+        out.push_back(value >> 16);
+        out.push_back(value >> 8);
+        out.push_back(value);
+    }
+};
+
+} // namespace gol
+
+#endif // GOL_FRAME_EXPORTER_H
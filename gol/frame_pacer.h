@@ -0,0 +1,50 @@
+#ifndef GOL_FRAME_PACER_H
+#define GOL_FRAME_PACER_H
+
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <ctime>
+
+namespace gol {
+
+// Paces displayed frames against absolute deadlines, so step and render time are absorbed into the frame period
+// instead of being added to it. Sleeps with clock_nanosleep(TIMER_ABSTIME) until shortly before the deadline and
+// spins for the rest, which avoids oversleeping by a scheduler tick.
+class FramePacer {
+public:
+    FramePacer(std::chrono::nanoseconds period, std::chrono::nanoseconds spin = std::chrono::microseconds(200))
+        : period(period.count()), spin(spin.count()), deadline(now() + period.count()) {}
+
+    void wait() {
+        if (period <= 0) return;
+
+        int64_t current = now();
+        if (current > deadline + period) {
+            // Fell more than a frame behind (slow render, stopped terminal): resync instead of bursting.
+            deadline = current + period;
+            return;
+        }
+
+        int64_t sleepUntil = deadline - spin;
+        if (sleepUntil > current) {
+            timespec ts{time_t(sleepUntil / 1000000000), long(sleepUntil % 1000000000)};
+            while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, nullptr) == EINTR) {}
+        }
+        while (now() < deadline) {}
+        deadline += period;
+    }
+
+private:
+    int64_t period, spin, deadline;
+
+    static int64_t now() {
+        timespec ts;
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        return int64_t(ts.tv_sec) * 1000000000 + ts.tv_nsec;
+    }
+};
+
+} // namespace gol
+
+#endif // GOL_FRAME_PACER_H
@@ -0,0 +1,315 @@
+#ifndef GOL_FRAME_SERVER_H
+#define GOL_FRAME_SERVER_H
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <iterator>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "dynamic_bitset.h"
+
+namespace gol {
+
+// Streams generations and per-generation stats to clients connected to a local Unix domain socket.
+//
+// The step loop only copies the latest frame into a slot and pokes an eventfd; an epoll loop on its own thread
+// does all socket work. A client that cannot keep up is never queued more than one message deep: once its
+// pending bytes drain it is sent the newest frame, skipping whatever it missed (drop-to-latest).
+//
+// Wire format, little-endian: u8 type, u64 generation, u32 payload length, payload.
+//   'K' keyframe and 'D' delta share the payload encoding: repeated (varint skip, varint count, count u64 words)
+//       runs of words to XOR into the client's copy of the grid. A keyframe XORs into an all-zero grid.
+//   'S' stats: one text line "generation=<n> population=<n> step_us=<n>\n".
+// Each frame is followed by the stats message for the same generation.
+class FrameServer {
+public:
+    FrameServer(const std::string& path, int width, int height)
+        : path(path), words((size_t(width) * height + 63) / 64), latestCells(words, 0), sentCells(words, 0) {
+        listenFd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+        if (listenFd < 0) {
+            std::cerr << "socket() failed: " << std::strerror(errno) << "\n";
+            return;
+        }
+
+        sockaddr_un addr{};
+        addr.sun_family = AF_UNIX;
+        if (path.size() >= sizeof(addr.sun_path)) {
+            std::cerr << "Socket path too long: " << path << "\n";
+            closeAll();
+            return;
+        }
+        std::strcpy(addr.sun_path, path.c_str());
+        unlink(path.c_str());
+        if (bind(listenFd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0 || listen(listenFd, 16) != 0) {
+            std::cerr << "Cannot listen on " << path << ": " << std::strerror(errno) << "\n";
+            closeAll();
+            return;
+        }
+
+        wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        epollFd = epoll_create1(EPOLL_CLOEXEC);
+        if (wakeFd < 0 || epollFd < 0) {
+            std::cerr << "epoll setup failed: " << std::strerror(errno) << "\n";
+            closeAll();
+            return;
+        }
+        watch(listenFd, EPOLLIN);
+        watch(wakeFd, EPOLLIN);
+
+        loop = std::thread(&FrameServer::eventLoop, this);
+    }
+
+    ~FrameServer() {
+        if (loop.joinable()) {
+            stopping.store(true);
+            uint64_t one = 1;
+            (void)!::write(wakeFd, &one, sizeof(one));
+            loop.join();
+        }
+        closeAll();
+    }
+
+    bool ok() const { return loop.joinable(); }
+
+    // Called from the step loop: never blocks on clients.
+    void publish(uint64_t generation, const DynamicBitset& grid, long long stepMicros) {
+        uint64_t population = 0;
+        for (size_t w = 0; w < grid.words(); ++w) {
+            population += __builtin_popcountll(grid.wordData()[w]);
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            std::memcpy(latestCells.data(), grid.wordData(), words * sizeof(uint64_t));
+            latestGeneration = generation;
+            latestPopulation = population;
+            latestStepMicros = stepMicros;
+            hasFrame = true;
+        }
+        uint64_t one = 1;
+        (void)!::write(wakeFd, &one, sizeof(one));
+    }
+
+private:
+    struct Client {
+        std::vector<uint64_t> cells; // What this client has been sent
+        bool synced = false;         // False until the first keyframe
+        uint64_t generation = 0;
+        std::vector<uint8_t> pending;
+        size_t offset = 0;
+        bool wantsWrite = false;
+    };
+
+    std::string path;
+    size_t words;
+    int listenFd = -1, wakeFd = -1, epollFd = -1;
+    std::thread loop;
+    std::atomic<bool> stopping{false};
+
+    // Latest frame, shared with the step loop.
+    std::mutex mutex;
+    std::vector<uint64_t> latestCells;
+    uint64_t latestGeneration = 0, latestPopulation = 0;
+    long long latestStepMicros = 0;
+    bool hasFrame = false;
+
+    // Event-loop-owned copy of the latest frame.
+    std::vector<uint64_t> sentCells;
+    uint64_t sentGeneration = 0, sentPopulation = 0;
+    long long sentStepMicros = 0;
+    bool haveSent = false;
+    std::map<int, Client> clients;
+
+    void watch(int fd, uint32_t events, int op = EPOLL_CTL_ADD) {
+        epoll_event ev{};
+        ev.events = events;
+        ev.data.fd = fd;
+        epoll_ctl(epollFd, op, fd, &ev);
+    }
+
+    void closeAll() {
+        for (auto& entry : clients) close(entry.first);
+        clients.clear();
+        if (listenFd >= 0) {
+            close(listenFd);
+            unlink(path.c_str());
+        }
+        if (wakeFd >= 0) close(wakeFd);
+        if (epollFd >= 0) close(epollFd);
+        listenFd = wakeFd = epollFd = -1;
+    }
+
+    void eventLoop() {
+        epoll_event events[64];
+        while (!stopping.load()) {
+            int n = epoll_wait(epollFd, events, 64, -1);
+            if (n < 0 && errno != EINTR) break;
+
+            for (int i = 0; i < n; ++i) {
+                int fd = events[i].data.fd;
+                if (fd == listenFd) {
+                    acceptClients();
+                } else if (fd == wakeFd) {
+                    uint64_t count;
+                    (void)!::read(wakeFd, &count, sizeof(count));
+                    takeLatest();
+                    for (auto it = clients.begin(); it != clients.end();) {
+                        auto next = std::next(it); // Dropping erases it
+                        if (!feed(it->first, it->second)) drop(it->first);
+                        it = next;
+                    }
+                } else {
+                    auto it = clients.find(fd);
+                    if (it == clients.end()) continue;
+                    if (events[i].events & (EPOLLHUP | EPOLLERR | EPOLLIN)) {
+                        char scratch[256];
+                        ssize_t got = recv(fd, scratch, sizeof(scratch), MSG_DONTWAIT);
+                        if (got == 0 || (got < 0 && errno != EAGAIN && errno != EWOULDBLOCK)) {
+                            drop(fd);
+                            continue;
+                        }
+                    }
+                    if ((events[i].events & EPOLLOUT) && !feed(fd, it->second)) {
+                        drop(fd);
+                    }
+                }
+            }
+        }
+    }
+
+    void acceptClients() {
+        while (true) {
+            int fd = accept4(listenFd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+            if (fd < 0) return;
+            Client& client = clients[fd];
+            client.cells.assign(words, 0);
+            watch(fd, EPOLLIN);
+            if (!feed(fd, client)) drop(fd);
+        }
+    }
+
+    void drop(int fd) {
+        epoll_ctl(epollFd, EPOLL_CTL_DEL, fd, nullptr);
+        close(fd);
+        clients.erase(fd);
+    }
+
+    void takeLatest() {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!hasFrame) return;
+        sentCells.swap(latestCells);
+        sentGeneration = latestGeneration;
+        sentPopulation = latestPopulation;
+        sentStepMicros = latestStepMicros;
+        hasFrame = false;
+        haveSent = true;
+    }
+
+    // Flush pending bytes; once drained, queue the newest frame if the client is behind. Returns false if the send
+    // failed and the caller should drop the client; feed never erases it, so callers may be iterating clients.
+    bool feed(int fd, Client& client) {
+        while (true) {
+            if (client.offset == client.pending.size()) {
+                client.pending.clear();
+                client.offset = 0;
+                if (!haveSent || (client.synced && client.generation == sentGeneration)) break;
+                encodeFrame(client);
+            }
+
+            ssize_t sent = send(fd, client.pending.data() + client.offset, client.pending.size() - client.offset, MSG_NOSIGNAL);
+            if (sent < 0) {
+                if (errno == EAGAIN || errno == EWOULDBLOCK) break;
+                return false;
+            }
+            client.offset += sent;
+        }
+
+        bool wantsWrite = client.offset < client.pending.size();
+        if (wantsWrite != client.wantsWrite) {
+            client.wantsWrite = wantsWrite;
+            watch(fd, EPOLLIN | (wantsWrite ? EPOLLOUT : 0), EPOLL_CTL_MOD);
+        }
+        return true;
+    }
+
+    void encodeFrame(Client& client) {
+        std::vector<uint8_t>& out = client.pending;
+        uint8_t type = client.synced ? 'D' : 'K';
+        if (!client.synced) {
+            std::fill(client.cells.begin(), client.cells.end(), 0);
+        }
+
+        size_t start = beginMessage(out, type, sentGeneration);
+        size_t w = 0, last = 0;
+        while (w < words) {
+            if (client.cells[w] == sentCells[w]) {
+                ++w;
+                continue;
+            }
+            size_t runStart = w;
+            while (w < words && client.cells[w] != sentCells[w]) ++w;
+            appendVarint(out, runStart - last);
+            appendVarint(out, w - runStart);
+            for (size_t i = runStart; i < w; ++i) {
+                appendLE(out, client.cells[i] ^ sentCells[i], 8);
+                client.cells[i] = sentCells[i];
+            }
+            last = w;
+        }
+        endMessage(out, start);
+
+        std::string stats = "generation=" + std::to_string(sentGeneration) +
+                            " population=" + std::to_string(sentPopulation) +
+                            " step_us=" + std::to_string(sentStepMicros) + "\n";
+        start = beginMessage(out, 'S', sentGeneration);
+        out.insert(out.end(), stats.begin(), stats.end());
+        endMessage(out, start);
+
+        client.synced = true;
+        client.generation = sentGeneration;
+    }
+
+    static size_t beginMessage(std::vector<uint8_t>& out, uint8_t type, uint64_t generation) {
+        out.push_back(type);
+        appendLE(out, generation, 8);
+        appendLE(out, 0, 4); // Length, patched by endMessage
+        return out.size();
+    }
+
+    static void endMessage(std::vector<uint8_t>& out, size_t payloadStart) {
+        uint32_t length = out.size() - payloadStart;
+        for (int i = 0; i < 4; ++i) {
+            out[payloadStart - 4 + i] = (length >> (8 * i)) & 0xFF;
+        }
+    }
+
+    static void appendLE(std::vector<uint8_t>& out, uint64_t value, int bytes) {
+        for (int i = 0; i < bytes; ++i) {
+            out.push_back((value >> (8 * i)) & 0xFF);
+        }
+    }
+
+    static void appendVarint(std::vector<uint8_t>& out, uint64_t value) {
+        while (value >= 0x80) {
+            out.push_back(uint8_t(value) | 0x80);
+            value >>= 7;
+        }
+        out.push_back(uint8_t(value));
+    }
+};
+
+} // namespace gol
+
+#endif // GOL_FRAME_SERVER_H
@@ -0,0 +1,25 @@
+#include "generation_stream.h"
+
+#include <algorithm>
+
+namespace gol {
+
+GenerationStream generations(Engine& engine, int every, uint64_t count) {
+    every = std::max(1, every);
+    uint64_t generation = engine.stats().generation; // Tracked here so each view doesn't cost a population count
+    for (uint64_t emitted = 0; count == 0 || emitted < count; ++emitted) {
+        if (emitted > 0) {
+            engine.step(every);
+            generation += every;
+        }
+        GenerationView view;
+        view.generation = generation;
+        view.width = engine.width();
+        view.height = engine.height();
+        view.cells = engine.cellBuffer();
+        view.engine = &engine;
+        co_yield view;
+    }
+}
+
+} // namespace gol
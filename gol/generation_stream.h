@@ -0,0 +1,132 @@
+#ifndef GOL_GENERATION_STREAM_H
+#define GOL_GENERATION_STREAM_H
+
+#include <coroutine>
+#include <cstdint>
+#include <exception>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+#include "dynamic_bitset.h"
+#include "engine.h"
+
+namespace gol {
+
+// One generation of a board as seen by a stream consumer. Nothing is copied: cells points at the engine's own
+// buffer, so a view is only valid until the stream is resumed.
+struct GenerationView {
+    uint64_t generation = 0;
+    int width = 0, height = 0;
+    CellBuffer cells; // Engine::cellBuffer(); words is nullptr if the engine has no bit buffer
+    const Engine* engine = nullptr;
+
+    bool test(int x, int y) const {
+        if (x < 0 || y < 0 || x >= width || y >= height) return false;
+        return cells.words ? cells.test(x, y) : engine->getRegion(x, y, 1, 1).test(0);
+    }
+};
+
+// A lazy sequence of generations, produced by a coroutine. The producer is suspended while the consumer holds a
+// view and only steps the board when the next one is requested, so a slow consumer slows the simulation instead of
+// piling up frames. Consume with a range-for loop, or with next()/view().
+class GenerationStream {
+public:
+    struct promise_type {
+        GenerationView current;
+        std::exception_ptr error;
+
+        GenerationStream get_return_object() {
+            return GenerationStream(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        std::suspend_always final_suspend() noexcept { return {}; }
+        std::suspend_always yield_value(const GenerationView& view) {
+            current = view;
+            return {};
+        }
+        void return_void() {}
+        void unhandled_exception() { error = std::current_exception(); }
+    };
+
+    class iterator {
+    public:
+        using value_type = GenerationView;
+        using difference_type = std::ptrdiff_t;
+
+        iterator() {}
+        explicit iterator(GenerationStream* stream) : stream(stream) {}
+
+        const GenerationView& operator*() const { return stream->view(); }
+        const GenerationView* operator->() const { return &stream->view(); }
+        iterator& operator++() {
+            if (!stream->next()) stream = nullptr;
+            return *this;
+        }
+        void operator++(int) { ++*this; }
+        bool operator==(std::default_sentinel_t) const { return stream == nullptr; }
+
+    private:
+        GenerationStream* stream = nullptr;
+    };
+
+    GenerationStream(GenerationStream&& other) noexcept : handle(std::exchange(other.handle, {})) {}
+    GenerationStream& operator=(GenerationStream&& other) noexcept {
+        if (this != &other) {
+            if (handle) handle.destroy();
+            handle = std::exchange(other.handle, {});
+        }
+        return *this;
+    }
+    GenerationStream(const GenerationStream&) = delete;
+    GenerationStream& operator=(const GenerationStream&) = delete;
+
+    ~GenerationStream() {
+        if (handle) handle.destroy();
+    }
+
+    // Run the producer up to its next generation. Returns false once the stream has ended; rethrows anything the
+    // producer threw.
+    bool next() {
+        if (!handle || handle.done()) return false;
+        handle.resume();
+        if (handle.promise().error) std::rethrow_exception(handle.promise().error);
+        return !handle.done();
+    }
+
+    bool done() const { return !handle || handle.done(); }
+
+    // The generation produced by the last successful next().
+    const GenerationView& view() const { return handle.promise().current; }
+
+    iterator begin() { return next() ? iterator(this) : iterator(); }
+    std::default_sentinel_t end() { return {}; }
+
+private:
+    explicit GenerationStream(std::coroutine_handle<promise_type> handle) : handle(handle) {}
+
+    std::coroutine_handle<promise_type> handle;
+};
+
+// The engine's current generation, then every `every`-th one after it, `count` views in all (0 = no end).
+// The engine must outlive the stream, and nothing else may step it while the stream is in use.
+GenerationStream generations(Engine& engine, int every = 1, uint64_t count = 0);
+
+// Cooperatively run several streams on the calling thread, one generation from each in turn. consume(index, view)
+// sees every view; returning false from it stops everything. Ends when every stream has ended.
+template <class Consumer>
+void interleave(std::vector<GenerationStream>& streams, Consumer consume) {
+    bool any = true;
+    while (any) {
+        any = false;
+        for (size_t i = 0; i < streams.size(); ++i) {
+            if (!streams[i].next()) continue;
+            any = true;
+            if (!consume(i, streams[i].view())) return;
+        }
+    }
+}
+
+} // namespace gol
+
+#endif // GOL_GENERATION_STREAM_H
@@ -0,0 +1,111 @@
+#ifndef GOL_HEATMAP_H
+#define GOL_HEATMAP_H
+
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "dynamic_bitset.h"
+
+namespace gol {
+
+// Per-cell activity accumulator: counts how often each cell changed state over a window of generations.
+// Counters are 8-bit and saturate at 255. They are updated 8 at a time with SWAR (SIMD within a register)
+// from the XOR of two generations, and words where nothing changed are skipped entirely.
+class ActivityHeatmap {
+public:
+    ActivityHeatmap(int width, int height, int window)
+        : width(width), height(height), window(window), generations(0),
+          counts((size_t(width) * height + 63) / 64 * 64, 0) {
+        for (int b = 0; b < 256; ++b) {
+            uint64_t spread = 0;
+            for (int i = 0; i < 8; ++i) {
+                if (b & (1 << i)) spread |= uint64_t(1) << (8 * i);
+            }
+            spreadBits[b] = spread;
+        }
+    }
+
+    // Add one generation of activity: every cell that differs between before and after is incremented.
+    void accumulate(const DynamicBitset& before, const DynamicBitset& after) {
+        const uint64_t* a = before.wordData();
+        const uint64_t* b = after.wordData();
+        for (size_t w = 0; w < before.words(); ++w) {
+            uint64_t changed = a[w] ^ b[w];
+            if (changed == 0) continue; // 64 idle cells
+
+            uint8_t* lane = &counts[w * 64];
+            for (int byte = 0; byte < 8; ++byte, changed >>= 8) {
+                uint64_t inc = spreadBits[changed & 0xFF];
+                if (inc == 0) continue;
+
+                uint64_t v;
+                std::memcpy(&v, lane + byte * 8, sizeof(v));
+                // Drop the increment for counters already at 255 (bytes of ~v that are zero).
+                uint64_t inv = ~v;
+                uint64_t full = ~(((inv & 0x7F7F7F7F7F7F7F7FULL) + 0x7F7F7F7F7F7F7F7FULL) | inv | 0x7F7F7F7F7F7F7F7FULL);
+                v += inc & ~(full >> 7);
+                std::memcpy(lane + byte * 8, &v, sizeof(v));
+            }
+        }
+        generations++;
+    }
+
+    // True once the current window is full. The caller exports and displays it, then calls clear() before
+    // accumulating the next generation.
+    bool windowComplete() const {
+        return window > 0 && generations >= window;
+    }
+
+    bool windowed() const { return window > 0; }
+
+    void clear() {
+        std::fill(counts.begin(), counts.end(), 0);
+        generations = 0;
+    }
+
+    uint8_t at(int x, int y) const {
+        return counts[size_t(y) * width + x];
+    }
+
+    // Write the counts as a binary PGM, scaled so the busiest cell is white.
+    bool writePGM(const std::string& path) const {
+        std::ofstream out(path, std::ios::binary);
+        if (!out) return false;
+
+        size_t cells = size_t(width) * height;
+        uint8_t maxCount = *std::max_element(counts.begin(), counts.begin() + cells);
+        out << "P5\n" << width << ' ' << height << '\n' << int(std::max<uint8_t>(maxCount, 1)) << '\n';
+        out.write(reinterpret_cast<const char*>(counts.data()), cells);
+        return bool(out);
+    }
+
+    // Render the cols x rows window whose top-left cell is (x0, y0).
+    void display(int x0, int y0, int cols, int rows) const {
+        for (int y = y0; y < std::min(height, y0 + rows); ++y) {
+            for (int x = x0; x < std::min(width, x0 + cols); ++x) {
+                uint8_t c = at(x, y);
+                if (c == 0) {
+                    std::cout << ' ';
+                } else {
+                    // Map onto the 24-step grayscale ramp (232..255) of the 256-color palette.
+                    int shade = 232 + std::min(23, c * 24 / std::max(generations, 1));
+                    std::cout << "\033[38;5;" << shade << "m█\033[0m";
+                }
+            }
+            std::cout << '\n';
+        }
+    }
+
+private:
+    int width, height, window, generations;
+    std::vector<uint8_t> counts; // Padded to whole 64-cell words
+    uint64_t spreadBits[256];    // Byte of bits -> one 0/1 per byte lane
+};
+
+} // namespace gol
+
+#endif // GOL_HEATMAP_H
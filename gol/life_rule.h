@@ -0,0 +1,57 @@
+#ifndef GOL_LIFE_RULE_H
+#define GOL_LIFE_RULE_H
+
+#include <cctype>
+#include <cstdint>
+#include <string>
+
+namespace gol {
+
+// A life-like rule chosen at run time. Bit n of birth / survive set means a dead / live cell with n live neighbors
+// is alive in the next generation. The default is Conway's B3/S23.
+struct LifeRule {
+    uint16_t birth = 1u << 3;
+    uint16_t survive = 1u << 2 | 1u << 3;
+
+    bool next(bool alive, int neighbors) const { return ((alive ? survive : birth) >> neighbors) & 1; }
+
+    bool operator==(const LifeRule& other) const { return birth == other.birth && survive == other.survive; }
+    bool operator!=(const LifeRule& other) const { return !(*this == other); }
+
+    // B3/S23, the rule the light cone, spaceship tracker and census are written for.
+    bool isConway() const { return *this == LifeRule(); }
+
+    // "B3/S23" notation, case-insensitive, either half may be empty ("B3/S"). Returns false on anything else.
+    static bool parse(const std::string& text, LifeRule& out) {
+        LifeRule rule;
+        rule.birth = rule.survive = 0;
+        uint16_t* masks[2] = {&rule.birth, &rule.survive};
+        const char letters[2] = {'B', 'S'};
+        size_t pos = 0;
+        for (int half = 0; half < 2; ++half) {
+            if (half == 1) {
+                if (pos >= text.size() || text[pos] != '/') return false;
+                ++pos;
+            }
+            if (pos >= text.size() || std::toupper(static_cast<unsigned char>(text[pos])) != letters[half]) return false;
+            for (++pos; pos < text.size() && text[pos] >= '0' && text[pos] <= '8'; ++pos) {
+                *masks[half] |= 1u << (text[pos] - '0');
+            }
+        }
+        if (pos != text.size()) return false;
+        out = rule;
+        return true;
+    }
+
+    std::string name() const {
+        std::string s = "B";
+        for (int n = 0; n <= 8; ++n) if ((birth >> n) & 1) s += char('0' + n);
+        s += "/S";
+        for (int n = 0; n <= 8; ++n) if ((survive >> n) & 1) s += char('0' + n);
+        return s;
+    }
+};
+
+} // namespace gol
+
+#endif // GOL_LIFE_RULE_H
@@ -0,0 +1,195 @@
+#ifndef GOL_LIGHT_CONE_H
+#define GOL_LIGHT_CONE_H
+
+#include <algorithm>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "dynamic_bitset.h"
+#include "metrics.h"
+#include "tiles.h"
+
+namespace gol {
+
+// Answers "what does this rectangle look like N generations from now" without stepping the whole board.
+// Only the backward light cone is simulated: the rectangle grown by N cells on every side (clipped to the board,
+// whose edges are dead), shrinking by one cell per generation. Every 64x64 tile that is exact at some intermediate
+// generation is cached, so repeated or overlapping queries start from the latest generation whose cone is already
+// fully cached. The cache is tied to one board state and dropped when the board changes.
+class LightCone {
+public:
+    LightCone(int width, int height, size_t maxTiles = 1 << 14)
+        : width(width), height(height), maxTiles(maxTiles) {}
+
+    // Cells of the w x h rectangle at (x0, y0), n generations after grid, row-major in a w * h bitset.
+    DynamicBitset query(const DynamicBitset& grid, uint64_t version, int x0, int y0, int w, int h, int n) {
+        if (version != cacheVersion) {
+            cache.clear();
+            cacheVersion = version;
+        }
+        DynamicBitset out(size_t(std::max(w, 0)) * std::max(h, 0));
+        if (w <= 0 || h <= 0 || empty(coneAt(x0, y0, w, h, 0))) return out; // Entirely off the board: all dead
+
+        // Latest generation whose whole cone slice is cached; 0 means start from the grid itself.
+        int start = n;
+        while (start > 0 && !cached(coneAt(x0, y0, w, h, n - start), start)) --start;
+        Metrics::recordCacheLookups(start, n - start);
+
+        Window win = alignedWindow(coneAt(x0, y0, w, h, n - start));
+        if (start == 0) {
+            for (int y = win.y0; y < win.y1; ++y) {
+                for (int i = 0; i < win.stride; ++i) {
+                    win.row(y)[i] = grid.bits(size_t(y) * width + win.x0 + i * 64, std::min(64, win.x1 - win.x0 - i * 64));
+                }
+            }
+        } else {
+            for (int ty = win.y0 >> ChangedTiles::SHIFT; ty <= (win.y1 - 1) >> ChangedTiles::SHIFT; ++ty) {
+                for (int tx = win.x0 >> ChangedTiles::SHIFT; tx <= (win.x1 - 1) >> ChangedTiles::SHIFT; ++tx) {
+                    const Tile& tile = cache.at(key(tx, ty, start));
+                    for (int r = 0; r < ChangedTiles::SIZE; ++r) {
+                        int y = (ty << ChangedTiles::SHIFT) + r;
+                        if (y >= win.y0 && y < win.y1) win.row(y)[tx - (win.x0 >> ChangedTiles::SHIFT)] = tile.rows[r];
+                    }
+                }
+            }
+        }
+
+        for (int k = start + 1; k <= n; ++k) {
+            Rect valid = coneAt(x0, y0, w, h, n - k);
+            step(win, std::max(win.y0, valid.y0), std::min(win.y1, valid.y1));
+            store(win, valid, k);
+        }
+
+        for (int y = 0; y < h; ++y) {
+            for (int x = 0; x < w; ++x) {
+                int bx = x0 + x, by = y0 + y;
+                if (bx < 0 || by < 0 || bx >= width || by >= height) continue;
+                int offset = bx - win.x0;
+                out.set(size_t(y) * w + x, (win.row(by)[offset >> 6] >> (offset & 63)) & 1);
+            }
+        }
+        return out;
+    }
+
+private:
+    struct Rect {
+        int x0, y0, x1, y1; // Half-open, clipped to the board
+    };
+
+    // Board rows y0..y1 and columns x0..x1 (x0 tile aligned), packed stride words per row.
+    struct Window {
+        int x0, y0, x1, y1, stride;
+        std::vector<uint64_t> cells, scratch;
+        uint64_t* row(int y) { return &cells[size_t(y - y0) * stride]; }
+    };
+
+    int width, height;
+    size_t maxTiles;
+    uint64_t cacheVersion = ~uint64_t(0);
+    std::unordered_map<uint64_t, Tile> cache;
+
+    static uint64_t key(int tx, int ty, int k) {
+        return (uint64_t(uint32_t(k)) << 40) | (uint64_t(uint32_t(ty)) << 20) | uint64_t(uint32_t(tx));
+    }
+
+    // The query rectangle grown by `margin` cells, clipped to the board.
+    Rect coneAt(int x0, int y0, int w, int h, int margin) const {
+        return Rect{std::max(0, x0 - margin), std::max(0, y0 - margin),
+                    std::min(width, x0 + w + margin), std::min(height, y0 + h + margin)};
+    }
+
+    static bool empty(const Rect& r) { return r.x0 >= r.x1 || r.y0 >= r.y1; }
+
+    bool cached(const Rect& r, int k) const {
+        if (empty(r)) return false;
+        for (int ty = r.y0 >> ChangedTiles::SHIFT; ty <= (r.y1 - 1) >> ChangedTiles::SHIFT; ++ty) {
+            for (int tx = r.x0 >> ChangedTiles::SHIFT; tx <= (r.x1 - 1) >> ChangedTiles::SHIFT; ++tx) {
+                if (!cache.count(key(tx, ty, k))) return false;
+            }
+        }
+        return true;
+    }
+
+    // Window covering r on whole tiles, so cached tiles map onto whole words.
+    Window alignedWindow(const Rect& r) const {
+        Window win;
+        win.x0 = r.x0 >> ChangedTiles::SHIFT << ChangedTiles::SHIFT;
+        win.x1 = std::min(width, ((r.x1 + ChangedTiles::SIZE - 1) >> ChangedTiles::SHIFT) << ChangedTiles::SHIFT);
+        win.y0 = r.y0 >> ChangedTiles::SHIFT << ChangedTiles::SHIFT;
+        win.y1 = std::min(height, ((r.y1 + ChangedTiles::SIZE - 1) >> ChangedTiles::SHIFT) << ChangedTiles::SHIFT);
+        win.stride = (win.x1 - win.x0 + 63) / 64;
+        win.cells.assign(size_t(win.y1 - win.y0) * win.stride, 0);
+        return win;
+    }
+
+    // One generation for rows y0..y1 of the window, 64 cells per word with a bit-sliced neighbor count.
+    // Cells outside the window are treated as dead; the caller only trusts the part the cone says is exact.
+    void step(Window& win, int y0, int y1) const {
+        win.scratch = win.cells;
+        const int stride = win.stride;
+        const int lastBits = (win.x1 - win.x0) - (stride - 1) * 64;
+        const uint64_t lastMask = lastBits == 64 ? ~uint64_t(0) : (uint64_t(1) << lastBits) - 1;
+        auto at = [&](int y, int i) -> uint64_t {
+            if (y < win.y0 || y >= win.y1 || i < 0 || i >= stride) return 0;
+            return win.scratch[size_t(y - win.y0) * stride + i];
+        };
+
+        for (int y = y0; y < y1; ++y) {
+            for (int i = 0; i < stride; ++i) {
+                uint64_t n[8];
+                int k = 0;
+                for (int dy = -1; dy <= 1; ++dy) {
+                    uint64_t c = at(y + dy, i);
+                    n[k++] = (c << 1) | (at(y + dy, i - 1) >> 63); // West neighbors
+                    n[k++] = (c >> 1) | (at(y + dy, i + 1) << 63); // East neighbors
+                    if (dy != 0) n[k++] = c;
+                }
+
+                // Sum eight 1-bit numbers per lane: ones + 2 * twos + 4 * fours (+ 8 * eights).
+                uint64_t s1, c1, s2, c2, ones, k1, t, tc;
+                add3(n[0], n[1], n[2], s1, c1);
+                add3(n[3], n[4], n[5], s2, c2);
+                uint64_t s3 = n[6] ^ n[7], c3 = n[6] & n[7];
+                add3(s1, s2, s3, ones, k1);
+                add3(c1, c2, c3, t, tc);
+                uint64_t twos = t ^ k1;
+                uint64_t fours = tc ^ (t & k1);
+                uint64_t eights = tc & t & k1;
+
+                uint64_t alive = at(y, i);
+                uint64_t next = twos & ~fours & ~eights & (ones | alive); // 3, or 2 and alive
+                if (i == stride - 1) next &= lastMask;
+                win.row(y)[i] = next;
+            }
+        }
+    }
+
+    static void add3(uint64_t a, uint64_t b, uint64_t c, uint64_t& sum, uint64_t& carry) {
+        uint64_t ab = a ^ b;
+        sum = ab ^ c;
+        carry = (a & b) | (ab & c);
+    }
+
+    // Cache every tile of the window that lies entirely inside the exact region for generation k.
+    void store(Window& win, const Rect& valid, int k) {
+        if (cache.size() >= maxTiles) return;
+        for (int ty = win.y0 >> ChangedTiles::SHIFT; ty <= (win.y1 - 1) >> ChangedTiles::SHIFT; ++ty) {
+            for (int tx = win.x0 >> ChangedTiles::SHIFT; tx <= (win.x1 - 1) >> ChangedTiles::SHIFT; ++tx) {
+                int cx0 = tx << ChangedTiles::SHIFT, cy0 = ty << ChangedTiles::SHIFT;
+                int cx1 = std::min(width, cx0 + ChangedTiles::SIZE), cy1 = std::min(height, cy0 + ChangedTiles::SIZE);
+                if (cx0 < valid.x0 || cy0 < valid.y0 || cx1 > valid.x1 || cy1 > valid.y1) continue;
+
+                Tile& tile = cache[key(tx, ty, k)];
+                for (int r = 0; r < ChangedTiles::SIZE; ++r) {
+                    int y = cy0 + r;
+                    tile.rows[r] = y < cy1 ? win.row(y)[tx - (win.x0 >> ChangedTiles::SHIFT)] : 0;
+                }
+            }
+        }
+    }
+};
+
+} // namespace gol
+
+#endif // GOL_LIGHT_CONE_H
@@ -0,0 +1,207 @@
+#ifndef GOL_METRICS_H
+#define GOL_METRICS_H
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unistd.h>
+
+namespace gol {
+
+// Process-wide run counters. Each thread increments its own cache-line-sized slot with relaxed atomics,
+// so the step loop never contends with other simulations or with the reader that sums the slots.
+class Metrics {
+public:
+    static constexpr int MAX_THREADS = 64;
+    static constexpr int LATENCY_BUCKETS = 40; // Bucket k counts steps taking [2^k, 2^(k+1)) ns
+
+    struct alignas(64) Slot {
+        std::atomic<uint64_t> generations{0};
+        std::atomic<uint64_t> cellUpdates{0};
+        std::atomic<uint64_t> soupsCompleted{0};
+        std::atomic<uint64_t> cacheHits{0};
+        std::atomic<uint64_t> cacheMisses{0};
+        std::atomic<uint64_t> resultCacheHits{0};
+        std::atomic<uint64_t> resultCacheMisses{0};
+        std::atomic<uint64_t> latency[LATENCY_BUCKETS] = {};
+    };
+
+    static Slot& local() {
+        thread_local Slot* slot = &slots()[nextSlot().fetch_add(1) % MAX_THREADS];
+        return *slot;
+    }
+
+    static void recordStep(uint64_t cells, uint64_t nanos) {
+        Slot& slot = local();
+        slot.generations.fetch_add(1, std::memory_order_relaxed);
+        slot.cellUpdates.fetch_add(cells, std::memory_order_relaxed);
+        int bucket = nanos ? std::min(LATENCY_BUCKETS - 1, 63 - __builtin_clzll(nanos)) : 0;
+        slot.latency[bucket].fetch_add(1, std::memory_order_relaxed);
+    }
+
+    static void recordSoupCompleted() {
+        local().soupsCompleted.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // Cache outcomes, counted in generations of a light-cone query served from cache versus recomputed.
+    static void recordCacheLookups(uint64_t hits, uint64_t misses) {
+        Slot& slot = local();
+        slot.cacheHits.fetch_add(hits, std::memory_order_relaxed);
+        slot.cacheMisses.fetch_add(misses, std::memory_order_relaxed);
+    }
+
+    // One board looked up in the ResultCache: served from it, or run.
+    static void recordResultCacheLookup(bool hit) {
+        (hit ? local().resultCacheHits : local().resultCacheMisses).fetch_add(1, std::memory_order_relaxed);
+    }
+
+    struct Totals {
+        uint64_t generations = 0, cellUpdates = 0, soupsCompleted = 0, cacheHits = 0, cacheMisses = 0;
+        uint64_t resultCacheHits = 0, resultCacheMisses = 0;
+        uint64_t latency[LATENCY_BUCKETS] = {};
+
+        // Upper bound of the histogram bucket holding quantile q, in seconds.
+        double latencyQuantile(double q) const {
+            uint64_t total = 0;
+            for (uint64_t count : latency) total += count;
+            if (total == 0) return 0;
+            uint64_t rank = uint64_t(q * (total - 1)) + 1, seen = 0;
+            for (int k = 0; k < LATENCY_BUCKETS; ++k) {
+                seen += latency[k];
+                if (seen >= rank) return double(uint64_t(2) << k) * 1e-9;
+            }
+            return 0;
+        }
+    };
+
+    static Totals totals() {
+        Totals t;
+        for (int i = 0; i < MAX_THREADS; ++i) {
+            Slot& slot = slots()[i];
+            t.generations += slot.generations.load(std::memory_order_relaxed);
+            t.cellUpdates += slot.cellUpdates.load(std::memory_order_relaxed);
+            t.soupsCompleted += slot.soupsCompleted.load(std::memory_order_relaxed);
+            t.cacheHits += slot.cacheHits.load(std::memory_order_relaxed);
+            t.cacheMisses += slot.cacheMisses.load(std::memory_order_relaxed);
+            t.resultCacheHits += slot.resultCacheHits.load(std::memory_order_relaxed);
+            t.resultCacheMisses += slot.resultCacheMisses.load(std::memory_order_relaxed);
+            for (int k = 0; k < LATENCY_BUCKETS; ++k) {
+                t.latency[k] += slot.latency[k].load(std::memory_order_relaxed);
+            }
+        }
+        return t;
+    }
+
+private:
+    static Slot* slots() {
+        static Slot storage[MAX_THREADS];
+        return storage;
+    }
+
+    static std::atomic<unsigned>& nextSlot() {
+        static std::atomic<unsigned> next{0};
+        return next;
+    }
+};
+
+// Periodically rewrites a Prometheus text-format snapshot of Metrics to a file. The snapshot is written to
+// a temporary file and renamed over the target, so scrapers never see a partial file.
+class MetricsFileWriter {
+public:
+    MetricsFileWriter(const std::string& path, std::chrono::milliseconds interval)
+        : path(path), interval(interval), thread(&MetricsFileWriter::loop, this) {}
+
+    ~MetricsFileWriter() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        wake.notify_all();
+        thread.join();
+        write(); // Final snapshot
+    }
+
+private:
+    std::string path;
+    std::chrono::milliseconds interval;
+    std::mutex mutex;
+    std::condition_variable wake;
+    bool stopping = false;
+    Metrics::Totals last;
+    std::chrono::steady_clock::time_point lastTime = std::chrono::steady_clock::now();
+    std::thread thread;
+
+    void loop() {
+        std::unique_lock<std::mutex> lock(mutex);
+        while (!wake.wait_for(lock, interval, [this] { return stopping; })) {
+            write();
+        }
+    }
+
+    static uint64_t residentBytes() {
+        std::ifstream statm("/proc/self/statm");
+        uint64_t pages = 0, resident = 0;
+        statm >> pages >> resident;
+        return resident * uint64_t(sysconf(_SC_PAGESIZE));
+    }
+
+    void write() {
+        Metrics::Totals now = Metrics::totals();
+        auto time = std::chrono::steady_clock::now();
+        double seconds = std::chrono::duration<double>(time - lastTime).count();
+        double genRate = seconds > 0 ? (now.generations - last.generations) / seconds : 0;
+        double cellRate = seconds > 0 ? (now.cellUpdates - last.cellUpdates) / seconds : 0;
+        last = now;
+        lastTime = time;
+
+        std::string tmp = path + ".tmp";
+        {
+            std::ofstream out(tmp);
+            out << "# TYPE gol_generations_total counter\n"
+                << "gol_generations_total " << now.generations << "\n"
+                << "# TYPE gol_generations_per_second gauge\n"
+                << "gol_generations_per_second " << genRate << "\n"
+                << "# TYPE gol_cell_updates_total counter\n"
+                << "gol_cell_updates_total " << now.cellUpdates << "\n"
+                << "# TYPE gol_cell_updates_per_second gauge\n"
+                << "gol_cell_updates_per_second " << cellRate << "\n"
+                << "# TYPE gol_soups_completed_total counter\n"
+                << "gol_soups_completed_total " << now.soupsCompleted << "\n"
+                << "# TYPE gol_lightcone_cache_hit_ratio gauge\n"
+                << "gol_lightcone_cache_hit_ratio "
+                << (now.cacheHits + now.cacheMisses ? double(now.cacheHits) / (now.cacheHits + now.cacheMisses) : 0) << "\n"
+                << "# TYPE gol_result_cache_hits_total counter\n"
+                << "gol_result_cache_hits_total " << now.resultCacheHits << "\n"
+                << "# TYPE gol_result_cache_misses_total counter\n"
+                << "gol_result_cache_misses_total " << now.resultCacheMisses << "\n"
+                << "# TYPE gol_result_cache_hit_ratio gauge\n"
+                << "gol_result_cache_hit_ratio "
+                << (now.resultCacheHits + now.resultCacheMisses
+                        ? double(now.resultCacheHits) / (now.resultCacheHits + now.resultCacheMisses) : 0) << "\n"
+                << "# TYPE gol_step_latency_seconds summary\n";
+            for (double q : {0.5, 0.9, 0.99, 0.999}) {
+                out << "gol_step_latency_seconds{quantile=\"" << q << "\"} " << now.latencyQuantile(q) << "\n";
+            }
+            out << "gol_step_latency_seconds_count " << now.generations << "\n"
+                << "# TYPE gol_resident_memory_bytes gauge\n"
+                << "gol_resident_memory_bytes " << residentBytes() << "\n";
+            if (!out) {
+                std::cerr << "Failed to write metrics to " << tmp << "\n";
+                return;
+            }
+        }
+        std::rename(tmp.c_str(), path.c_str());
+    }
+};
+
+} // namespace gol
+
+#endif // GOL_METRICS_H
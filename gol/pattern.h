@@ -0,0 +1,221 @@
+#ifndef GOL_PATTERN_H
+#define GOL_PATTERN_H
+
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "dynamic_bitset.h"
+
+namespace gol {
+
+// A small pattern (at most 62x62, so it fits a word with a one-cell margin). Bit x of rows[y] is cell (x, y).
+struct Pattern {
+    int width = 0, height = 0;
+    std::vector<uint64_t> rows;
+
+    bool test(int x, int y) const { return (rows[y] >> x) & 1; }
+
+    // Parse plaintext (".O" rows, '!' comment lines) or RLE ("x = ..." header, b/o/$ runs, '!' terminator).
+    // In plaintext a blank line inside the pattern is an empty row; blank lines before and after it are ignored.
+    static bool parse(const std::string& text, Pattern& out) {
+        std::vector<std::string> lines;
+        std::istringstream in(text);
+        std::string line;
+        bool rle = false;
+        while (std::getline(in, line)) {
+            if (!line.empty() && line.back() == '\r') line.pop_back();
+            if (!line.empty() && (line[0] == '!' || line[0] == '#')) continue;
+            if (line.empty() && lines.empty()) continue;
+            if (line[0] == 'x') {
+                rle = true;
+                continue;
+            }
+            lines.push_back(line);
+        }
+
+        std::vector<std::string> grid;
+        if (rle) {
+            std::string body;
+            for (const std::string& l : lines) body += l;
+            grid.emplace_back();
+            int count = 0;
+            for (char c : body) {
+                if (std::isdigit(static_cast<unsigned char>(c))) {
+                    count = count * 10 + (c - '0');
+                    continue;
+                }
+                int n = std::max(count, 1);
+                count = 0;
+                if (c == 'b' || c == '.') grid.back().append(n, '.');
+                else if (c == 'o' || c == 'O') grid.back().append(n, 'O');
+                else if (c == '$') for (int i = 0; i < n; ++i) grid.emplace_back();
+                else if (c == '!') break;
+            }
+        } else {
+            grid = lines;
+            while (!grid.empty() && grid.back().empty()) grid.pop_back();
+        }
+
+        out = Pattern();
+        out.height = int(grid.size());
+        for (const std::string& row : grid) out.width = std::max<int>(out.width, row.size());
+        if (out.width == 0 || out.width > 62 || out.height > 62) return false;
+        for (const std::string& row : grid) {
+            uint64_t bits = 0;
+            for (size_t x = 0; x < row.size(); ++x) {
+                if (row[x] == 'O' || row[x] == '*') bits |= uint64_t(1) << x;
+            }
+            out.rows.push_back(bits);
+        }
+        return true;
+    }
+
+    // Symmetry i of the dihedral group D4: bit 0 mirrors x, bit 1 mirrors y, bit 2 transposes (applied first).
+    Pattern transformed(int symmetry) const {
+        Pattern p;
+        bool transpose = symmetry & 4;
+        p.width = transpose ? height : width;
+        p.height = transpose ? width : height;
+        p.rows.assign(p.height, 0);
+        for (int y = 0; y < height; ++y) {
+            for (int x = 0; x < width; ++x) {
+                if (!test(x, y)) continue;
+                int tx = transpose ? y : x, ty = transpose ? x : y;
+                if (symmetry & 1) tx = p.width - 1 - tx;
+                if (symmetry & 2) ty = p.height - 1 - ty;
+                p.rows[ty] |= uint64_t(1) << tx;
+            }
+        }
+        return p;
+    }
+
+    bool operator==(const Pattern& other) const {
+        return width == other.width && height == other.height && rows == other.rows;
+    }
+
+    // The pattern one generation later, run in isolation and trimmed to its new bounding box.
+    Pattern stepped() const {
+        auto alive = [this](int x, int y) { return x >= 0 && y >= 0 && x < width && y < height && test(x, y); };
+        std::vector<std::pair<int, int>> cells;
+        for (int y = -1; y <= height; ++y) {
+            for (int x = -1; x <= width; ++x) {
+                int n = 0;
+                for (int dy = -1; dy <= 1; ++dy) {
+                    for (int dx = -1; dx <= 1; ++dx) {
+                        if (dx || dy) n += alive(x + dx, y + dy);
+                    }
+                }
+                if (n == 3 || (n == 2 && alive(x, y))) cells.push_back({x, y});
+            }
+        }
+
+        Pattern p;
+        if (cells.empty()) return p;
+        int minX = cells[0].first, minY = cells[0].second, maxX = minX, maxY = minY;
+        for (const auto& c : cells) {
+            minX = std::min(minX, c.first);
+            maxX = std::max(maxX, c.first);
+            minY = std::min(minY, c.second);
+            maxY = std::max(maxY, c.second);
+        }
+        p.width = maxX - minX + 1;
+        p.height = maxY - minY + 1;
+        p.rows.assign(p.height, 0);
+        for (const auto& c : cells) p.rows[c.second - minY] |= uint64_t(1) << (c.first - minX);
+        return p;
+    }
+};
+
+// Finds every placement of a pattern, in all of its distinct orientations, in a board.
+// 64 candidate x positions are tested at once: each pattern cell ANDs a shifted word of the board row (or its
+// complement, for dead cells) into a candidate mask, live cells first, and a position block is abandoned as soon
+// as the mask is empty. With `isolated` the pattern must also be surrounded by a ring of dead cells.
+class PatternSearch {
+public:
+    struct Match {
+        int x, y;     // Top-left of the pattern's bounding box
+        int symmetry; // Orientation matched, see Pattern::transformed
+    };
+
+    PatternSearch(const Pattern& pattern, bool isolated) : isolated(isolated) {
+        for (int symmetry = 0; symmetry < 8; ++symmetry) {
+            Pattern p = pattern.transformed(symmetry);
+            bool duplicate = false;
+            for (const Variant& v : variants) duplicate = duplicate || v.pattern == p;
+            if (duplicate) continue;
+
+            Variant v{p, symmetry, {}};
+            int pad = isolated ? 1 : 0;
+            for (int pass = 1; pass >= 0; --pass) { // Live cells first: they reject empty space fastest
+                for (int y = -pad; y < p.height + pad; ++y) {
+                    for (int x = -pad; x < p.width + pad; ++x) {
+                        bool alive = x >= 0 && y >= 0 && x < p.width && y < p.height && p.test(x, y);
+                        if (alive == bool(pass)) v.cells.push_back(Cell{x, y, alive});
+                    }
+                }
+            }
+            variants.push_back(v);
+        }
+    }
+
+    // Matches whose bounding box starts inside [x0, x1) x [y0, y1) and lies on the board.
+    std::vector<Match> find(const DynamicBitset& grid, int width, int height, int x0, int y0, int x1, int y1) const {
+        std::vector<Match> matches;
+        for (const Variant& v : variants) {
+            int yStart = std::max(y0, 0), yEnd = std::min(y1, height - v.pattern.height + 1);
+            int xStart = std::max(x0, 0), xEnd = std::min(x1, width - v.pattern.width + 1);
+            for (int y = yStart; y < yEnd; ++y) {
+                for (int xb = xStart; xb < xEnd; xb += 64) {
+                    int candidates = std::min(64, xEnd - xb);
+                    uint64_t mask = candidates == 64 ? ~uint64_t(0) : (uint64_t(1) << candidates) - 1;
+                    for (const Cell& c : v.cells) {
+                        uint64_t row = rowBits(grid, width, height, y + c.y, xb + c.x);
+                        mask &= c.alive ? row : ~row;
+                        if (!mask) break;
+                    }
+                    while (mask) {
+                        matches.push_back(Match{xb + __builtin_ctzll(mask), y, v.symmetry});
+                        mask &= mask - 1;
+                    }
+                }
+            }
+        }
+        return matches;
+    }
+
+    std::vector<Match> find(const DynamicBitset& grid, int width, int height) const {
+        return find(grid, width, height, 0, 0, width, height);
+    }
+
+private:
+    struct Cell {
+        int x, y;
+        bool alive;
+    };
+
+    struct Variant {
+        Pattern pattern;
+        int symmetry;
+        std::vector<Cell> cells; // Cells to check, relative to the bounding box, margin included
+    };
+
+    bool isolated;
+    std::vector<Variant> variants;
+
+    // 64 cells of row y starting at column x; cells off the board read as dead.
+    static uint64_t rowBits(const DynamicBitset& grid, int width, int height, int y, int x) {
+        if (y < 0 || y >= height || x >= width || x <= -64) return 0;
+        size_t base = size_t(y) * width;
+        if (x >= 0) return grid.bits(base + x, std::min(64, width - x));
+        return grid.bits(base, std::min(64 + x, width)) << (-x);
+    }
+};
+
+} // namespace gol
+
+#endif // GOL_PATTERN_H
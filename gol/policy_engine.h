@@ -0,0 +1,362 @@
+#ifndef GOL_POLICY_ENGINE_H
+#define GOL_POLICY_ENGINE_H
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "dynamic_bitset.h"
+#include "engine.h"
+
+namespace gol {
+
+// An engine assembled from four compile-time policies. Each combination instantiates its own kernel, so the inner
+// loop has no virtual calls or runtime switches; the only virtual call is Engine::step itself.
+//
+//   Storage       how cells are kept: get/set/clear/population/packed, a name, and optionally row words (see
+//                 RowBitStorage), which selects the word-parallel kernel
+//   Rule          static next(alive, neighbors), plus birth/survive bit masks for the word-parallel kernel
+//   Boundary      static wrap(v, n): the on-board coordinate for v, or -1 if that neighbor is always dead
+//   Neighborhood  count and dx/dy offsets, each within one cell
+
+// One bit per cell, each row starting on a word boundary so the kernel can work a whole word of a row at a time.
+// Bits past the width in a row's last word are always 0.
+class RowBitStorage {
+public:
+    RowBitStorage(int width, int height)
+        : width(width), stride((width + 63) >> 6), words(size_t(stride) * height, 0) {}
+
+    static std::string name() { return "bits"; }
+
+    bool get(int x, int y) const { return (row(y)[x >> 6] >> (x & 63)) & 1; }
+
+    void set(int x, int y, bool alive) {
+        uint64_t mask = uint64_t(1) << (x & 63);
+        uint64_t& word = row(y)[x >> 6];
+        word = alive ? word | mask : word & ~mask;
+    }
+
+    void clear() { std::fill(words.begin(), words.end(), 0); }
+
+    uint64_t population() const {
+        uint64_t count = 0;
+        for (uint64_t word : words) count += __builtin_popcountll(word);
+        return count;
+    }
+
+    // Row-major copy, cell (x, y) at bit y * width + x.
+    DynamicBitset packed() const {
+        int height = int(words.size() / stride);
+        DynamicBitset out(size_t(width) * height);
+        for (int y = 0; y < height; ++y) {
+            for (int i = 0; i < stride; ++i) {
+                out.setBits(size_t(y) * width + (i << 6), std::min(64, width - (i << 6)), row(y)[i]);
+            }
+        }
+        return out;
+    }
+
+    int rowWords() const { return stride; }
+    const uint64_t* data() const { return words.data(); }
+    const uint64_t* row(int y) const { return &words[size_t(y) * stride]; }
+    uint64_t* row(int y) { return &words[size_t(y) * stride]; }
+
+private:
+    int width, stride;
+    std::vector<uint64_t> words;
+};
+
+// One byte per cell. Slower to step, but the simplest possible layout; useful as a reference.
+class ByteStorage {
+public:
+    ByteStorage(int width, int height) : width(width), cells(size_t(width) * height, 0) {}
+
+    static std::string name() { return "bytes"; }
+
+    bool get(int x, int y) const { return cells[size_t(y) * width + x]; }
+    void set(int x, int y, bool alive) { cells[size_t(y) * width + x] = alive; }
+    void clear() { std::fill(cells.begin(), cells.end(), 0); }
+
+    uint64_t population() const { return std::count(cells.begin(), cells.end(), 1); }
+
+    DynamicBitset packed() const {
+        DynamicBitset out(cells.size());
+        for (size_t i = 0; i < cells.size(); ++i) {
+            if (cells[i]) out.set(i, true);
+        }
+        return out;
+    }
+
+private:
+    int width;
+    std::vector<uint8_t> cells;
+};
+
+// Birth and Survive are bit masks over neighbor counts: bit n set means a cell with n live neighbors is born / survives.
+template <unsigned Birth, unsigned Survive>
+struct LifeLikeRule {
+    static constexpr unsigned birth = Birth;
+    static constexpr unsigned survive = Survive;
+
+    static bool next(bool alive, int neighbors) { return ((alive ? Survive : Birth) >> neighbors) & 1; }
+
+    static std::string name() {
+        std::string s = "B";
+        for (int n = 0; n <= 8; ++n) if ((Birth >> n) & 1) s += char('0' + n);
+        s += "S";
+        for (int n = 0; n <= 8; ++n) if ((Survive >> n) & 1) s += char('0' + n);
+        return s;
+    }
+};
+
+using ConwayRule = LifeLikeRule<1u << 3, 1u << 2 | 1u << 3>;
+using HighLifeRule = LifeLikeRule<1u << 3 | 1u << 6, 1u << 2 | 1u << 3>;
+
+// Cells off the board are dead.
+struct DeadBoundary {
+    static std::string name() { return "dead"; }
+    static int wrap(int v, int n) { return v >= 0 && v < n ? v : -1; }
+};
+
+// Opposite edges are joined.
+struct TorusBoundary {
+    static std::string name() { return "torus"; }
+    static int wrap(int v, int n) {
+        v %= n;
+        return v < 0 ? v + n : v;
+    }
+};
+
+struct MooreNeighborhood {
+    static std::string name() { return "moore"; }
+    static constexpr int count = 8;
+    static constexpr int dx[count] = {-1, 0, 1, -1, 1, -1, 0, 1};
+    static constexpr int dy[count] = {-1, -1, -1, 0, 0, 1, 1, 1};
+};
+
+struct VonNeumannNeighborhood {
+    static std::string name() { return "vonneumann"; }
+    static constexpr int count = 4;
+    static constexpr int dx[count] = {0, -1, 1, 0};
+    static constexpr int dy[count] = {-1, 0, 0, 1};
+};
+
+// One generation, cell by cell. Works with any storage; interior cells skip the boundary policy.
+template <class Storage, class Rule, class Boundary, class Neighborhood>
+struct PolicyKernel {
+    static void step(const Storage& cur, Storage& next, int width, int height) {
+        for (int y = 0; y < height; ++y) {
+            bool interiorRow = y > 0 && y < height - 1;
+            for (int x = 0; x < width; ++x) {
+                int neighbors = 0;
+                if (interiorRow && x > 0 && x < width - 1) {
+                    for (int k = 0; k < Neighborhood::count; ++k) {
+                        neighbors += cur.get(x + Neighborhood::dx[k], y + Neighborhood::dy[k]);
+                    }
+                } else {
+                    for (int k = 0; k < Neighborhood::count; ++k) {
+                        int nx = Boundary::wrap(x + Neighborhood::dx[k], width);
+                        int ny = Boundary::wrap(y + Neighborhood::dy[k], height);
+                        if (nx >= 0 && ny >= 0) neighbors += cur.get(nx, ny);
+                    }
+                }
+                next.set(x, y, Rule::next(cur.get(x, y), neighbors));
+            }
+        }
+    }
+};
+
+// One generation, 64 cells per word: each neighbor becomes a shifted copy of a row word, the copies are summed into
+// bit-sliced counters, and the rule becomes a mask of the counts it accepts (the same scheme as LightCone::step).
+template <class Rule, class Boundary, class Neighborhood>
+struct PolicyKernel<RowBitStorage, Rule, Boundary, Neighborhood> {
+    static void step(const RowBitStorage& cur, RowBitStorage& next, int width, int height) {
+        const int stride = cur.rowWords();
+        const int lastBit = (width - 1) & 63;
+        const uint64_t lastMask = lastBit == 63 ? ~uint64_t(0) : (uint64_t(2) << lastBit) - 1;
+        const int west = Boundary::wrap(-1, width), east = Boundary::wrap(width, width);
+
+        for (int y = 0; y < height; ++y) {
+            const uint64_t* rows[3];
+            uint64_t westBits[3], eastBits[3]; // The off-board neighbors of each row's first and last cell
+            for (int r = 0; r < 3; ++r) {
+                int sy = Boundary::wrap(y + r - 1, height);
+                rows[r] = sy < 0 ? nullptr : cur.row(sy);
+                westBits[r] = rows[r] && west >= 0 ? (rows[r][west >> 6] >> (west & 63)) & 1 : 0;
+                eastBits[r] = rows[r] && east >= 0 ? (rows[r][east >> 6] >> (east & 63)) & 1 : 0;
+            }
+
+            uint64_t* out = next.row(y);
+            for (int i = 0; i < stride; ++i) {
+                uint64_t in[Neighborhood::count];
+                for (int k = 0; k < Neighborhood::count; ++k) {
+                    in[k] = shifted(rows, westBits, eastBits, Neighborhood::dy[k] + 1, Neighborhood::dx[k], i, stride, lastBit);
+                }
+                uint64_t counts[4];
+                sum(in, counts);
+
+                uint64_t alive = rows[1][i];
+                uint64_t result = apply(counts, alive, std::make_index_sequence<9>());
+                out[i] = i == stride - 1 ? result & lastMask : result;
+            }
+        }
+    }
+
+    // Word i of row r with each bit replaced by its neighbor dx cells away.
+    static uint64_t shifted(const uint64_t* const* rows, const uint64_t* westBits, const uint64_t* eastBits,
+                            int r, int dx, int i, int stride, int lastBit) {
+        const uint64_t* row = rows[r];
+        if (!row) return 0;
+        uint64_t c = row[i];
+        if (dx < 0) {
+            return (c << 1) | (i > 0 ? row[i - 1] >> 63 : westBits[r]);
+        }
+        if (dx > 0) {
+            uint64_t v = (c >> 1) | (i + 1 < stride ? row[i + 1] << 63 : 0);
+            return i == stride - 1 ? v | (eastBits[r] << lastBit) : v;
+        }
+        return c;
+    }
+
+    // counts[b] holds bit b of each lane's neighbor count.
+    static void sum(const uint64_t (&in)[8], uint64_t (&counts)[4]) {
+        uint64_t s1, c1, s2, c2, ones, k1, t, tc;
+        add3(in[0], in[1], in[2], s1, c1);
+        add3(in[3], in[4], in[5], s2, c2);
+        uint64_t s3 = in[6] ^ in[7], c3 = in[6] & in[7];
+        add3(s1, s2, s3, ones, k1);
+        add3(c1, c2, c3, t, tc);
+        counts[0] = ones;
+        counts[1] = t ^ k1;
+        counts[2] = tc ^ (t & k1);
+        counts[3] = tc & t & k1;
+    }
+
+    template <size_t N>
+    static void sum(const uint64_t (&in)[N], uint64_t (&counts)[4]) {
+        counts[0] = counts[1] = counts[2] = counts[3] = 0;
+        for (size_t k = 0; k < N; ++k) {
+            uint64_t carry = in[k];
+            for (int b = 0; b < 4; ++b) {
+                uint64_t c = counts[b] & carry;
+                counts[b] ^= carry;
+                carry = c;
+            }
+        }
+    }
+
+    static void add3(uint64_t a, uint64_t b, uint64_t c, uint64_t& sum, uint64_t& carry) {
+        uint64_t ab = a ^ b;
+        sum = ab ^ c;
+        carry = (a & b) | (ab & c);
+    }
+
+    // Lanes whose count is exactly n.
+    static uint64_t equals(const uint64_t (&counts)[4], int n) {
+        return (n & 1 ? counts[0] : ~counts[0]) & (n & 2 ? counts[1] : ~counts[1]) &
+               (n & 4 ? counts[2] : ~counts[2]) & (n & 8 ? counts[3] : ~counts[3]);
+    }
+
+    // Expanded at compile time over the counts 0..8, so only the counts the rule accepts generate code.
+    template <size_t... N>
+    static uint64_t apply(const uint64_t (&counts)[4], uint64_t alive, std::index_sequence<N...>) {
+        uint64_t born = 0, kept = 0;
+        ((born |= ((Rule::birth >> N) & 1) ? equals(counts, N) : 0), ...);
+        ((kept |= ((Rule::survive >> N) & 1) ? equals(counts, N) : 0), ...);
+        return (born & ~alive) | (kept & alive);
+    }
+};
+
+template <class Storage, class Rule, class Boundary, class Neighborhood>
+class PolicyEngine : public Engine {
+public:
+    PolicyEngine(int width, int height)
+        : boardWidth(width), boardHeight(height), cur(width, height), next(width, height) {}
+
+    // "<storage>/<rule>/<boundary>/<neighborhood>", e.g. "bits/B3S23/dead/moore".
+    static std::string policyName() {
+        return Storage::name() + "/" + Rule::name() + "/" + Boundary::name() + "/" + Neighborhood::name();
+    }
+
+    std::string name() const override { return policyName(); }
+    int width() const override { return boardWidth; }
+    int height() const override { return boardHeight; }
+
+    void step(int generations) override {
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < generations; ++i) {
+            PolicyKernel<Storage, Rule, Boundary, Neighborhood>::step(cur, next, boardWidth, boardHeight);
+            std::swap(cur, next);
+            generation++;
+        }
+        stepCalls++;
+        stepMicros += std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - start).count();
+    }
+
+    DynamicBitset getRegion(int x, int y, int w, int h) const override {
+        DynamicBitset out(size_t(std::max(w, 0)) * std::max(h, 0));
+        for (int row = 0; row < h; ++row) {
+            for (int col = 0; col < w; ++col) {
+                if (onBoard(x + col, y + row)) out.set(size_t(row) * w + col, cur.get(x + col, y + row));
+            }
+        }
+        return out;
+    }
+
+    void setRegion(int x, int y, int w, int h, const DynamicBitset& cells) override {
+        for (int row = 0; row < h; ++row) {
+            for (int col = 0; col < w; ++col) {
+                if (onBoard(x + col, y + row)) cur.set(x + col, y + row, cells.test(size_t(row) * w + col));
+            }
+        }
+    }
+
+    EngineStats stats() const override {
+        EngineStats s;
+        s.generation = generation;
+        s.population = cur.population();
+        s.stepCalls = stepCalls;
+        s.stepMicros = stepMicros;
+        return s;
+    }
+
+    // Word-aligned rows are exposed as they are; other storages have no bit buffer.
+    CellBuffer cellBuffer() const override {
+        if constexpr (requires { cur.rowWords(); }) {
+            return CellBuffer{cur.data(), size_t(cur.rowWords()) * boardHeight, size_t(cur.rowWords()) * 64};
+        } else {
+            return CellBuffer();
+        }
+    }
+
+    // Same mixing as CellularAutomaton::hash, so equal boards hash equally whichever engine holds them.
+    uint64_t hash() const override {
+        return cur.packed().hash() ^ (uint64_t(uint32_t(boardWidth)) << 32 | uint32_t(boardHeight)) * 0x9E3779B97F4A7C15ULL;
+    }
+
+private:
+    int boardWidth, boardHeight;
+    Storage cur, next;
+    uint64_t generation = 0;
+    uint64_t stepCalls = 0;
+    uint64_t stepMicros = 0;
+
+    bool onBoard(int x, int y) const { return x >= 0 && y >= 0 && x < boardWidth && y < boardHeight; }
+};
+
+// Add a policy combination to the registry under its policyName().
+template <class Storage, class Rule, class Boundary, class Neighborhood>
+bool registerPolicyEngine(EngineRegistry& registry) {
+    using E = PolicyEngine<Storage, Rule, Boundary, Neighborhood>;
+    return registry.add(E::policyName(), [](int width, int height) {
+        return std::unique_ptr<Engine>(new E(width, height));
+    });
+}
+
+} // namespace gol
+
+#endif // GOL_POLICY_ENGINE_H
@@ -0,0 +1,164 @@
+#include "result_cache.h"
+
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <vector>
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace gol {
+
+static const char CACHE_MAGIC[8] = {'G', 'O', 'L', 'R', 'C', '0', '0', '1'};
+
+ResultCache::ResultCache(const std::string& path, uint64_t initialCapacity) : path(path) {
+    fd = open(path.c_str(), O_CREAT | O_RDWR, 0644);
+    if (fd < 0) {
+        std::cerr << "open(" << path << ") failed: " << std::strerror(errno) << "\n";
+        return;
+    }
+    if (flock(fd, LOCK_EX | LOCK_NB) != 0) {
+        std::cerr << "Result cache " << path << " is in use by another process\n";
+        close(fd);
+        fd = -1;
+        return;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) == 0 && st.st_size >= off_t(sizeof(Header))) {
+        Header existing;
+        if (pread(fd, &existing, sizeof(existing), 0) != ssize_t(sizeof(existing)) ||
+            std::memcmp(existing.magic, CACHE_MAGIC, 8) != 0 ||
+            st.st_size != off_t(sizeof(Header) + existing.capacity * sizeof(Slot))) {
+            std::cerr << "Not a result cache (or from another version): " << path << "\n";
+            return;
+        }
+        map(existing.capacity, false);
+    } else {
+        uint64_t capacity = 64;
+        while (capacity < initialCapacity) capacity <<= 1;
+        map(capacity, true);
+    }
+}
+
+ResultCache::~ResultCache() {
+    unmap();
+    if (fd >= 0) {
+        close(fd); // Also releases the flock
+    }
+}
+
+bool ResultCache::lookup(const Key& key, Outcome& outcome) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!base) return false;
+    Slot* slot = find(key);
+    if (!slot->used) return false;
+    outcome = slot->outcome;
+    return true;
+}
+
+void ResultCache::insert(const Key& key, const Outcome& outcome) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!base) return;
+    if ((header()->count + 1) * 4 > header()->capacity * 3) {
+        grow();
+        if (!base) return;
+    }
+    Slot* slot = find(key);
+    if (!slot->used) {
+        slot->initialHash = key.initialHash;
+        slot->width = key.width;
+        slot->height = key.height;
+        slot->birth = key.birth;
+        slot->survive = key.survive;
+        slot->boundary = key.boundary;
+        header()->count++;
+    }
+    slot->outcome = outcome;
+    slot->used = 1;
+}
+
+uint64_t ResultCache::size() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return base ? header()->count : 0;
+}
+
+bool ResultCache::map(uint64_t capacity, bool create) {
+    size_t newLength = sizeof(Header) + capacity * sizeof(Slot);
+    if (create && ftruncate(fd, newLength) != 0) {
+        std::cerr << "ftruncate(" << path << ") failed: " << std::strerror(errno) << "\n";
+        return false;
+    }
+    void* mapping = mmap(nullptr, newLength, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (mapping == MAP_FAILED) {
+        std::cerr << "mmap(" << path << ") failed: " << std::strerror(errno) << "\n";
+        return false;
+    }
+    base = static_cast<uint8_t*>(mapping);
+    length = newLength;
+    if (create) {
+        std::memcpy(header()->magic, CACHE_MAGIC, 8);
+        header()->capacity = capacity;
+        header()->count = 0;
+    }
+    return true;
+}
+
+void ResultCache::unmap() {
+    if (base) {
+        munmap(base, length);
+        base = nullptr;
+    }
+}
+
+void ResultCache::grow() {
+    uint64_t capacity = header()->capacity;
+    std::vector<Slot> entries;
+    entries.reserve(header()->count);
+    for (uint64_t i = 0; i < capacity; ++i) {
+        if (slots()[i].used) entries.push_back(slots()[i]);
+    }
+
+    // The file is rewritten from scratch at twice the size: ftruncate zero-fills the new slots, and the old ones
+    // are cleared before the entries go back in at their new positions.
+    unmap();
+    if (!map(capacity * 2, true)) return;
+    std::memset(static_cast<void*>(slots()), 0, capacity * 2 * sizeof(Slot));
+    for (const Slot& entry : entries) {
+        Key key;
+        key.initialHash = entry.initialHash;
+        key.width = entry.width;
+        key.height = entry.height;
+        key.birth = entry.birth;
+        key.survive = entry.survive;
+        key.boundary = entry.boundary;
+        *find(key) = entry;
+        header()->count++;
+    }
+}
+
+ResultCache::Slot* ResultCache::find(const Key& key) const {
+    uint64_t mask = header()->capacity - 1;
+    for (uint64_t i = mix(key) & mask;; i = (i + 1) & mask) {
+        Slot& slot = slots()[i];
+        if (!slot.used || matches(slot, key)) return &slot;
+    }
+}
+
+uint64_t ResultCache::mix(const Key& key) {
+    uint64_t h = key.initialHash;
+    h ^= (uint64_t(key.width) << 32 | key.height) * 0x9E3779B97F4A7C15ULL;
+    h ^= (uint64_t(key.birth) << 24 | uint64_t(key.survive) << 8 | key.boundary) * 0xBF58476D1CE4E5B9ULL;
+    h = (h ^ (h >> 31)) * 0x94D049BB133111EBULL;
+    return h ^ (h >> 29);
+}
+
+bool ResultCache::matches(const Slot& slot, const Key& key) {
+    return slot.initialHash == key.initialHash && slot.width == key.width && slot.height == key.height &&
+           slot.birth == key.birth && slot.survive == key.survive && slot.boundary == key.boundary;
+}
+
+} // namespace gol
@@ -0,0 +1,82 @@
+#ifndef GOL_RESULT_CACHE_H
+#define GOL_RESULT_CACHE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+
+#include "census.h"
+
+namespace gol {
+
+// Outcomes of settled boards, kept in a memory-mapped file so a later run can skip any board it has seen before.
+// The file is an open-addressing hash table with linear probing that doubles when 3/4 full. It is locked with
+// flock while open, so only one process uses a cache file at a time; within a process every method is thread-safe.
+class ResultCache {
+public:
+    // Everything that determines how a board evolves.
+    struct Key {
+        uint64_t initialHash = 0; // CellularAutomaton::hash() before the first step
+        uint32_t width = 0, height = 0;
+        uint16_t birth = 0, survive = 0;
+        uint8_t boundary = 0; // 0 = dead cells off the board (the only boundary CellularAutomaton has)
+    };
+
+    struct Outcome {
+        int32_t lifespan = 0; // Generations until the board settled
+        int32_t period = 0;   // 1 stable, 2 alternating
+        uint64_t finalPopulation = 0;
+        uint64_t finalHash = 0;
+        Census::Counts census{};
+    };
+
+    explicit ResultCache(const std::string& path, uint64_t initialCapacity = 1 << 16);
+    ~ResultCache();
+
+    bool ok() const { return base != nullptr; }
+
+    bool lookup(const Key& key, Outcome& outcome);
+    void insert(const Key& key, const Outcome& outcome);
+
+    // Outcomes stored.
+    uint64_t size() const;
+
+private:
+    struct Header {
+        char magic[8];
+        uint64_t capacity; // Slots, a power of two
+        uint64_t count;
+    };
+
+    struct Slot {
+        uint64_t initialHash;
+        uint32_t width, height;
+        uint16_t birth, survive;
+        uint8_t boundary;
+        uint8_t used; // Written last, so a slot is never seen half-filled
+        uint8_t padding[2];
+        Outcome outcome;
+    };
+
+    std::string path;
+    int fd = -1;
+    uint8_t* base = nullptr;
+    size_t length = 0;
+    mutable std::mutex mutex;
+
+    Header* header() const { return reinterpret_cast<Header*>(base); }
+    Slot* slots() const { return reinterpret_cast<Slot*>(base + sizeof(Header)); }
+
+    bool map(uint64_t capacity, bool create);
+    void unmap();
+    void grow();
+    Slot* find(const Key& key) const; // The key's slot, or the empty slot where it would go
+
+    static uint64_t mix(const Key& key);
+    static bool matches(const Slot& slot, const Key& key);
+};
+
+} // namespace gol
+
+#endif // GOL_RESULT_CACHE_H
@@ -0,0 +1,118 @@
+#ifndef GOL_REWIND_BUFFER_H
+#define GOL_REWIND_BUFFER_H
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <utility>
+#include <vector>
+
+#include "dynamic_bitset.h"
+
+namespace gol {
+
+// Bounded history for stepping backward and forward through recent generations.
+// Each generation is stored as the sparse XOR delta from the one before it (only words that changed), with a full
+// keyframe every keyframeInterval generations. Because XOR is its own inverse, one step back or forward is a single
+// pass over one delta; seeking further starts from whichever is closer, the current state or the nearest keyframe.
+class RewindBuffer {
+public:
+    RewindBuffer(size_t capacity, int keyframeInterval)
+        : capacity(std::max<size_t>(capacity, 2)), keyframeInterval(std::max(keyframeInterval, 1)) {}
+
+    // Record grid as generation, given the previous generation's grid. With no previous state, stores a keyframe.
+    void record(const DynamicBitset& grid, int generation, const DynamicBitset* previous) {
+        Entry entry;
+        entry.generation = generation;
+        if (previous && !entries.empty() && entries.back().generation == generation - 1) {
+            const uint64_t* a = previous->wordData();
+            const uint64_t* b = grid.wordData();
+            for (size_t w = 0; w < grid.words(); ++w) {
+                if (a[w] != b[w]) entry.delta.push_back({w, a[w] ^ b[w]});
+            }
+        } else {
+            entries.clear(); // Discontinuous: start over from this state
+        }
+        if (entries.empty() || generation % keyframeInterval == 0) {
+            entry.keyframe.assign(grid.wordData(), grid.wordData() + grid.words());
+        }
+        entries.push_back(std::move(entry));
+
+        while (entries.size() > capacity) {
+            // The new oldest entry must be a keyframe: rebuild it from the one being dropped.
+            Entry& next = entries[1];
+            if (next.keyframe.empty()) {
+                next.keyframe = std::move(entries.front().keyframe);
+                for (const auto& change : next.delta) next.keyframe[change.first] ^= change.second;
+            }
+            entries.pop_front();
+        }
+    }
+
+    int oldest() const { return entries.empty() ? 0 : entries.front().generation; }
+    int newest() const { return entries.empty() ? 0 : entries.back().generation; }
+
+    // Turn grid, currently at generation `current`, into generation `target`. Both must be within [oldest, newest].
+    bool seek(DynamicBitset& grid, int current, int target) const {
+        if (entries.empty() || current < oldest() || current > newest() || target < oldest() || target > newest()) {
+            return false;
+        }
+
+        size_t targetIndex = target - oldest();
+        size_t keyIndex = targetIndex;
+        while (entries[keyIndex].keyframe.empty()) --keyIndex;
+
+        size_t index = current - oldest();
+        size_t fromCurrent = index > targetIndex ? index - targetIndex : targetIndex - index;
+        if (targetIndex - keyIndex < fromCurrent) {
+            std::memcpy(grid.wordData(), entries[keyIndex].keyframe.data(), grid.words() * sizeof(uint64_t));
+            index = keyIndex;
+        }
+        for (; index > targetIndex; --index) apply(grid, entries[index]);
+        for (; index < targetIndex; ++index) apply(grid, entries[index + 1]);
+        return true;
+    }
+
+    // Apply an edit (XOR of one word) to the newest recorded generation.
+    void amend(size_t word, uint64_t bits) {
+        if (entries.empty()) return;
+        Entry& entry = entries.back();
+        if (!entry.keyframe.empty()) {
+            entry.keyframe[word] ^= bits;
+        }
+        auto it = std::lower_bound(entry.delta.begin(), entry.delta.end(), std::make_pair(word, uint64_t(0)));
+        if (it != entry.delta.end() && it->first == word) {
+            it->second ^= bits;
+        } else {
+            entry.delta.insert(it, {word, bits});
+        }
+    }
+
+    // Forget everything after generation.
+    void truncateAfter(int generation) {
+        while (!entries.empty() && entries.back().generation > generation) entries.pop_back();
+    }
+
+    void clear() { entries.clear(); }
+
+private:
+    struct Entry {
+        int generation;
+        std::vector<std::pair<size_t, uint64_t>> delta; // (word, XOR from the previous generation)
+        std::vector<uint64_t> keyframe;                 // Full grid, or empty
+    };
+
+    size_t capacity;
+    int keyframeInterval;
+    std::deque<Entry> entries;
+
+    static void apply(DynamicBitset& grid, const Entry& entry) {
+        uint64_t* words = grid.wordData();
+        for (const auto& change : entry.delta) words[change.first] ^= change.second;
+    }
+};
+
+} // namespace gol
+
+#endif // GOL_REWIND_BUFFER_H
@@ -0,0 +1,38 @@
+#ifndef GOL_SEED_H
+#define GOL_SEED_H
+
+#include <cstdint>
+
+namespace gol {
+
+// SplitMix64: a 64-bit generator whose whole state is one word, so every board can own one cheaply and any seed
+// (including 0) is a good one. Meets UniformRandomBitGenerator, so it works with the <random> distributions.
+class SplitMix64 {
+public:
+    using result_type = uint64_t;
+
+    explicit SplitMix64(uint64_t seed) : state(seed) {}
+
+    static constexpr uint64_t min() { return 0; }
+    static constexpr uint64_t max() { return ~uint64_t(0); }
+
+    uint64_t operator()() {
+        uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+
+private:
+    uint64_t state;
+};
+
+// The seed of child `index` of `parent`, for the master -> job -> soup hierarchy. It depends only on the two
+// arguments, so a soup's board is the same whichever thread builds it and in whatever order.
+inline uint64_t deriveSeed(uint64_t parent, uint64_t index) {
+    return SplitMix64(parent ^ (index * 0xD1B54A32D192ED03ULL))();
+}
+
+} // namespace gol
+
+#endif // GOL_SEED_H
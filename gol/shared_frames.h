@@ -0,0 +1,104 @@
+#ifndef GOL_SHARED_FRAMES_H
+#define GOL_SHARED_FRAMES_H
+
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <new>
+#include <string>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "dynamic_bitset.h"
+
+namespace gol {
+
+// Layout of the shared-memory segment written by SharedFramePublisher. The packed grid (same bit order
+// as DynamicBitset: cell y * width + x is bit (i & 63) of word i >> 6) follows the header at cellsOffset.
+//
+// Readers use the seqlock protocol and never block the writer:
+//   1. s1 = sequence (acquire); if s1 is odd a frame is being written, retry.
+//   2. read generation and the cells (in place, or copy them out).
+//   3. acquire fence; s2 = sequence; if s1 != s2 the frame was overwritten meanwhile, retry.
+struct SharedFrameHeader {
+    char magic[8];                  // "GOLSHM1"
+    uint32_t width, height;
+    uint64_t words;                 // Number of 64-bit words of cells
+    uint64_t cellsOffset;           // Byte offset of the cells from the start of the segment
+    std::atomic<uint64_t> sequence; // Odd while a frame is being written
+    uint64_t generation;
+};
+
+// Publishes each generation into a POSIX shared-memory segment so external viewers can read frames
+// at their own pace. Publishing is a single memcpy bracketed by the sequence counter; it never waits on readers.
+class SharedFramePublisher {
+public:
+    SharedFramePublisher(const std::string& name, int width, int height) : name(name) {
+        size_t words = (size_t(width) * height + 63) / 64;
+        size_t offset = (sizeof(SharedFrameHeader) + 63) / 64 * 64;
+        length = offset + words * sizeof(uint64_t);
+
+        int fd = shm_open(name.c_str(), O_CREAT | O_RDWR, 0644);
+        if (fd < 0) {
+            std::cerr << "shm_open(" << name << ") failed: " << std::strerror(errno) << "\n";
+            return;
+        }
+        if (ftruncate(fd, length) != 0) {
+            std::cerr << "ftruncate(" << name << ") failed: " << std::strerror(errno) << "\n";
+            close(fd);
+            return;
+        }
+        void* mapping = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        close(fd);
+        if (mapping == MAP_FAILED) {
+            std::cerr << "mmap(" << name << ") failed: " << std::strerror(errno) << "\n";
+            return;
+        }
+
+        base = static_cast<uint8_t*>(mapping);
+        header = new (base) SharedFrameHeader();
+        std::memcpy(header->magic, "GOLSHM1", 8);
+        header->width = width;
+        header->height = height;
+        header->words = words;
+        header->cellsOffset = offset;
+        header->sequence.store(0, std::memory_order_release);
+        cells = reinterpret_cast<uint64_t*>(base + offset);
+    }
+
+    ~SharedFramePublisher() {
+        if (base) {
+            munmap(base, length);
+            shm_unlink(name.c_str());
+        }
+    }
+
+    bool ok() const { return base != nullptr; }
+
+    void publish(uint64_t generation, const DynamicBitset& grid) {
+        if (!base) return;
+
+        uint64_t seq = header->sequence.load(std::memory_order_relaxed);
+        header->sequence.store(seq + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        header->generation = generation;
+        std::memcpy(cells, grid.wordData(), grid.words() * sizeof(uint64_t));
+
+        header->sequence.store(seq + 2, std::memory_order_release);
+    }
+
+private:
+    std::string name;
+    size_t length = 0;
+    uint8_t* base = nullptr;
+    SharedFrameHeader* header = nullptr;
+    uint64_t* cells = nullptr;
+};
+
+} // namespace gol
+
+#endif // GOL_SHARED_FRAMES_H
@@ -0,0 +1,23 @@
+#include "signals.h"
+
+namespace gol {
+
+volatile std::sig_atomic_t statsRequested = 0;
+volatile std::sig_atomic_t stopRequested = 0;
+
+extern "C" void onStatsSignal(int) { statsRequested = 1; }
+extern "C" void onStopSignal(int) { stopRequested = 1; }
+
+void installSignalHandlers(bool stopInterruptsReads) {
+    struct sigaction action{};
+    sigemptyset(&action.sa_mask);
+    action.sa_flags = SA_RESTART;
+
+    action.sa_handler = onStatsSignal;
+    sigaction(SIGUSR1, &action, nullptr);
+    action.sa_handler = onStopSignal;
+    action.sa_flags = stopInterruptsReads ? 0 : SA_RESTART;
+    sigaction(SIGTERM, &action, nullptr);
+}
+
+} // namespace gol
@@ -0,0 +1,19 @@
+#ifndef GOL_SIGNALS_H
+#define GOL_SIGNALS_H
+
+#include <csignal>
+
+namespace gol {
+
+// Set by signal handlers and polled by the step loop; the handlers do nothing else, which keeps them async-signal-safe.
+// SIGUSR1 asks for a stats dump, SIGTERM for a checkpoint and a clean exit after the current generation.
+extern volatile std::sig_atomic_t statsRequested;
+extern volatile std::sig_atomic_t stopRequested;
+
+// Route SIGUSR1 and SIGTERM to the flags above. With stopInterruptsReads, SIGTERM makes a blocking read fail with
+// EINTR instead of restarting it, so a loop waiting on input (e.g. the next job line from a pipe) notices at once.
+void installSignalHandlers(bool stopInterruptsReads = false);
+
+} // namespace gol
+
+#endif // GOL_SIGNALS_H
@@ -0,0 +1,164 @@
+#ifndef GOL_SNAPSHOT_HISTORY_H
+#define GOL_SNAPSHOT_HISTORY_H
+
+#include <algorithm>
+#include <deque>
+#include <memory>
+#include <unordered_set>
+#include <vector>
+
+#include "dynamic_bitset.h"
+#include "tiles.h"
+
+namespace gol {
+
+// Bounded history of board snapshots with copy-on-write structural sharing.
+// A snapshot is the root of a persistent tree: each node has FANOUT reference-counted children, and the bottom level
+// points at tiles. A new generation copies only the nodes on the paths to changed tiles and loads only those tiles,
+// so unchanged subtrees (and every empty tile) are shared between snapshots. Each capture then costs
+// O(changed tiles * depth), independent of the board size.
+class SnapshotHistory {
+public:
+    static constexpr int FANOUT_SHIFT = 6;
+    static constexpr int FANOUT = 1 << FANOUT_SHIFT; // Children per node
+
+    SnapshotHistory(int width, int height, size_t capacity)
+        : width(width), height(height),
+          tilesX((width + ChangedTiles::SIZE - 1) >> ChangedTiles::SHIFT),
+          tilesY((height + ChangedTiles::SIZE - 1) >> ChangedTiles::SHIFT),
+          capacity(std::max<size_t>(capacity, 1)), emptyTile(std::make_shared<Tile>()) {
+        while ((size_t(1) << (FANOUT_SHIFT * depth)) < size_t(tilesX) * tilesY) depth++;
+    }
+
+    // Record grid as generation. With `changed` (the tiles that differ from the previous capture) only those tiles are
+    // copied; without it the whole board is.
+    void capture(const DynamicBitset& grid, int generation, const ChangedTiles* changed) {
+        Snapshot next;
+        next.generation = generation;
+
+        if (snapshots.empty() || !changed) {
+            next.root = build(grid, depth - 1, 0);
+        } else {
+            std::vector<int> tiles = changed->list();
+            std::sort(tiles.begin(), tiles.end());
+            next.root = snapshots.back().root;
+            if (!tiles.empty()) next.root = update(grid, *next.root, depth - 1, 0, tiles.data(), tiles.data() + tiles.size());
+        }
+
+        snapshots.push_back(std::move(next));
+        if (snapshots.size() > capacity) {
+            snapshots.pop_front();
+        }
+    }
+
+    void clear() { snapshots.clear(); }
+    size_t size() const { return snapshots.size(); }
+    int generationAt(size_t index) const { return snapshots[index].generation; }
+
+    // Write snapshot `index` (0 = oldest) back into grid.
+    void restore(size_t index, DynamicBitset& grid) const {
+        restore(*snapshots[index].root, depth - 1, 0, grid);
+    }
+
+    // Distinct tiles held across all snapshots, i.e. what the history actually costs.
+    size_t distinctTiles() const {
+        std::unordered_set<const void*> seen; // Nodes already walked, and tiles
+        size_t tiles = 0;
+        for (const Snapshot& snapshot : snapshots) {
+            tiles += countTiles(*snapshot.root, depth - 1, seen);
+        }
+        return tiles;
+    }
+
+private:
+    // Slots of bottom-level nodes hold tiles; slots of the levels above hold nodes. Slots past the board are null.
+    struct Node {
+        std::shared_ptr<const void> slots[FANOUT];
+    };
+
+    struct Snapshot {
+        int generation;
+        std::shared_ptr<const Node> root;
+    };
+
+    int width, height, tilesX, tilesY;
+    int depth = 1; // Node levels; FANOUT^depth >= tile count
+    size_t capacity;
+    std::shared_ptr<const Tile> emptyTile;
+    std::deque<Snapshot> snapshots;
+
+    int tileCount() const { return tilesX * tilesY; }
+
+    // Tiles under one slot of a node at `level`.
+    static int slotSpan(int level) { return 1 << (FANOUT_SHIFT * level); }
+
+    std::shared_ptr<const Node> build(const DynamicBitset& grid, int level, int first) const {
+        auto node = std::make_shared<Node>();
+        int span = slotSpan(level);
+        for (int i = 0; i < FANOUT && first + i * span < tileCount(); ++i) {
+            int t = first + i * span;
+            if (level == 0) {
+                node->slots[i] = loadTile(grid, t);
+            } else {
+                node->slots[i] = build(grid, level - 1, t);
+            }
+        }
+        return node;
+    }
+
+    // Copy of node with the sorted tiles [begin, end), all under it, reloaded from grid.
+    std::shared_ptr<const Node> update(const DynamicBitset& grid, const Node& node, int level, int first,
+                                       const int* begin, const int* end) const {
+        auto copy = std::make_shared<Node>(node);
+        int span = slotSpan(level);
+        while (begin != end) {
+            int i = (*begin - first) / span;
+            const int* groupEnd = begin;
+            while (groupEnd != end && (*groupEnd - first) / span == i) ++groupEnd;
+            if (level == 0) {
+                copy->slots[i] = loadTile(grid, *begin);
+            } else {
+                auto child = std::static_pointer_cast<const Node>(node.slots[i]);
+                copy->slots[i] = update(grid, *child, level - 1, first + i * span, begin, groupEnd);
+            }
+            begin = groupEnd;
+        }
+        return copy;
+    }
+
+    void restore(const Node& node, int level, int first, DynamicBitset& grid) const {
+        int span = slotSpan(level);
+        for (int i = 0; i < FANOUT && node.slots[i]; ++i) {
+            int t = first + i * span;
+            if (level == 0) {
+                static_cast<const Tile*>(node.slots[i].get())->store(grid, width, height, t % tilesX, t / tilesX);
+            } else {
+                restore(*static_cast<const Node*>(node.slots[i].get()), level - 1, t, grid);
+            }
+        }
+    }
+
+    size_t countTiles(const Node& node, int level, std::unordered_set<const void*>& seen) const {
+        if (!seen.insert(&node).second) return 0; // Shared subtree, already counted
+        size_t tiles = 0;
+        for (int i = 0; i < FANOUT && node.slots[i]; ++i) {
+            if (level == 0) {
+                tiles += seen.insert(node.slots[i].get()).second;
+            } else {
+                tiles += countTiles(*static_cast<const Node*>(node.slots[i].get()), level - 1, seen);
+            }
+        }
+        return tiles;
+    }
+
+    std::shared_ptr<const Tile> loadTile(const DynamicBitset& grid, int t) const {
+        auto tile = std::make_shared<Tile>();
+        tile->load(grid, width, height, t % tilesX, t / tilesX);
+        if (tile->empty()) return emptyTile;
+        return tile;
+    }
+};
+
+} // namespace gol
+
+#endif // GOL_SNAPSHOT_HISTORY_H
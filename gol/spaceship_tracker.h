@@ -0,0 +1,186 @@
+#ifndef GOL_SPACESHIP_TRACKER_H
+#define GOL_SPACESHIP_TRACKER_H
+
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <ostream>
+#include <set>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "dynamic_bitset.h"
+#include "pattern.h"
+#include "tiles.h"
+
+namespace gol {
+
+// Finds the standard spaceships (glider, LWSS, MWSS, HWSS) each generation, follows them as tracks and logs
+// collisions. Only the neighborhood of changed tiles is searched, which is where every moving ship is.
+//
+// A track missing for a few generations is lost. Tracks lost in the same generation close to each other are
+// reported as one collision with all of them as participants; a lone lost ship is reported as a collision with
+// whatever it hit (debris, still lifes or the board edge).
+class SpaceshipTracker {
+public:
+    struct Track {
+        int id;
+        std::string type;
+        int firstGeneration, lastGeneration;
+        std::vector<std::array<int, 3>> path; // (generation, x, y) of the bounding box
+    };
+
+    SpaceshipTracker(std::ostream& log) : log(log) {
+        addType("glider", ".O.\n..O\nOOO\n");
+        addType("LWSS", ".O..O\nO....\nO...O\nOOOO.\n");
+        addType("MWSS", "...O..\n.O...O\nO.....\nO....O\nOOOOO.\n");
+        addType("HWSS", "...OO..\n.O....O\nO......\nO.....O\nOOOOOO.\n");
+    }
+
+    void update(const DynamicBitset& grid, int width, int height, const ChangedTiles& changed, int generation) {
+        std::vector<Detection> found = detect(grid, width, height, changed);
+
+        // Continue each active track with the nearest detection of the same type.
+        std::vector<bool> used(found.size(), false);
+        for (Track& track : active) {
+            const auto& last = track.path.back();
+            int best = -1, bestDistance = MATCH_DISTANCE + 1;
+            for (size_t i = 0; i < found.size(); ++i) {
+                if (used[i] || found[i].type != track.type) continue;
+                int distance = std::max(std::abs(found[i].x - last[1]), std::abs(found[i].y - last[2]));
+                if (distance < bestDistance) {
+                    best = int(i);
+                    bestDistance = distance;
+                }
+            }
+            if (best >= 0) {
+                used[best] = true;
+                track.lastGeneration = generation;
+                track.path.push_back({generation, found[best].x, found[best].y});
+            }
+        }
+
+        for (size_t i = 0; i < found.size(); ++i) {
+            if (used[i]) continue;
+            active.push_back(Track{nextId++, found[i].type, generation, generation, {{generation, found[i].x, found[i].y}}});
+        }
+
+        std::vector<Track> lost;
+        for (size_t i = 0; i < active.size(); ) {
+            if (generation - active[i].lastGeneration > GRACE_GENERATIONS) {
+                lost.push_back(std::move(active[i]));
+                active.erase(active.begin() + i);
+            } else {
+                ++i;
+            }
+        }
+        reportCollisions(lost);
+        for (Track& track : lost) finished.push_back(std::move(track));
+    }
+
+    // Write one line per track seen so far: id, type, lifetime and start/end positions.
+    void summarize() const {
+        for (const std::vector<Track>* list : {&finished, &active}) {
+            for (const Track& t : *list) {
+                log << "track #" << t.id << " " << t.type << " generations " << t.firstGeneration << "-" << t.lastGeneration
+                    << " from (" << t.path.front()[1] << ", " << t.path.front()[2] << ") to ("
+                    << t.path.back()[1] << ", " << t.path.back()[2] << ")" << (list == &active ? " active" : "") << "\n";
+            }
+        }
+        log << std::flush;
+    }
+
+    const std::vector<Track>& activeTracks() const { return active; }
+
+private:
+    static constexpr int MATCH_DISTANCE = 3;    // Bounding boxes move at most this far between detections
+    static constexpr int GRACE_GENERATIONS = 4; // A ship may look non-isolated briefly (passing debris) and survive
+    static constexpr int COLLISION_RADIUS = 12; // Lost tracks this close together belong to one collision
+
+    struct ShipType {
+        std::string name;
+        std::vector<PatternSearch> phases;
+        int reach; // Largest bounding-box side over all phases
+    };
+
+    struct Detection {
+        std::string type;
+        int x, y;
+    };
+
+    std::ostream& log;
+    std::vector<ShipType> types;
+    std::vector<Track> active, finished;
+    int nextId = 1;
+
+    void addType(const std::string& name, const std::string& cells) {
+        Pattern phase;
+        Pattern::parse(cells, phase);
+        ShipType type{name, {}, 0};
+        for (int i = 0; i < 4; ++i) { // All four phases of these c/4 and c/2 ships
+            type.phases.emplace_back(phase, true);
+            type.reach = std::max({type.reach, phase.width, phase.height});
+            phase = phase.stepped();
+        }
+        types.push_back(std::move(type));
+    }
+
+    std::vector<Detection> detect(const DynamicBitset& grid, int width, int height, const ChangedTiles& changed) const {
+        std::vector<Detection> found;
+        std::set<std::tuple<std::string, int, int>> seen; // Windows of neighboring tiles overlap
+        for (int tile : changed.list()) {
+            int x0 = (tile % changed.columns()) << ChangedTiles::SHIFT;
+            int y0 = (tile / changed.columns()) << ChangedTiles::SHIFT;
+            for (const ShipType& type : types) {
+                for (const PatternSearch& phase : type.phases) {
+                    for (const PatternSearch::Match& m : phase.find(grid, width, height, x0 - type.reach, y0 - type.reach,
+                                                                    x0 + ChangedTiles::SIZE, y0 + ChangedTiles::SIZE)) {
+                        if (seen.insert(std::make_tuple(type.name, m.x, m.y)).second) {
+                            found.push_back(Detection{type.name, m.x, m.y});
+                        }
+                    }
+                }
+            }
+        }
+        return found;
+    }
+
+    void reportCollisions(std::vector<Track>& lost) {
+        std::vector<bool> reported(lost.size(), false);
+        for (size_t i = 0; i < lost.size(); ++i) {
+            if (reported[i]) continue;
+
+            // Group with every other lost track near any member of the group.
+            std::vector<size_t> group = {i};
+            reported[i] = true;
+            for (size_t g = 0; g < group.size(); ++g) {
+                const auto& a = lost[group[g]].path.back();
+                for (size_t j = 0; j < lost.size(); ++j) {
+                    const auto& b = lost[j].path.back();
+                    if (!reported[j] && std::max(std::abs(a[1] - b[1]), std::abs(a[2] - b[2])) <= COLLISION_RADIUS) {
+                        reported[j] = true;
+                        group.push_back(j);
+                    }
+                }
+            }
+
+            int x = 0, y = 0, last = 0;
+            for (size_t index : group) {
+                x += lost[index].path.back()[1];
+                y += lost[index].path.back()[2];
+                last = std::max(last, lost[index].lastGeneration);
+            }
+            log << "generation " << last + 1 << " collision at (" << x / int(group.size()) << ", " << y / int(group.size()) << "):";
+            for (size_t index : group) {
+                log << " #" << lost[index].id << " " << lost[index].type;
+            }
+            log << "\n";
+        }
+        if (!lost.empty()) log << std::flush;
+    }
+};
+
+} // namespace gol
+
+#endif // GOL_SPACESHIP_TRACKER_H
@@ -0,0 +1,225 @@
+#ifndef GOL_SYMMETRIC_SOUP_H
+#define GOL_SYMMETRIC_SOUP_H
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "dynamic_bitset.h"
+
+namespace gol {
+
+// Random initial boards with a symmetry. Only one cell of each symmetry orbit (the fundamental domain) is drawn at
+// random; the rest of the board is filled by applying the symmetry group to it with whole-word operations: bit
+// reversal of rows for left-right mirrors, row reordering for top-bottom mirrors and 64x64 bit-matrix transposes for
+// diagonal ones.
+//
+//   C1  no symmetry                          C2  180-degree rotation
+//   C4  90-degree rotation (square boards)   D4  mirrored left-right and top-bottom
+//   D8  all eight rotations and reflections of the square (square boards)
+class SymmetricSoup {
+public:
+    enum Symmetry { C1, C2, C4, D4, D8 };
+
+    static const char* name(Symmetry symmetry) {
+        static const char* const names[] = {"C1", "C2", "C4", "D4", "D8"};
+        return names[symmetry];
+    }
+
+    static bool parse(const std::string& text, Symmetry& out) {
+        for (Symmetry s : {C1, C2, C4, D4, D8}) {
+            if (text == name(s)) {
+                out = s;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    static bool needsSquare(Symmetry symmetry) { return symmetry == C4 || symmetry == D8; }
+
+    // A width x height board, packed row-major like CellularAutomaton's grid, with each domain cell alive with
+    // probability density. needsSquare() symmetries must have width == height.
+    template <class Generator>
+    static DynamicBitset generate(int width, int height, Symmetry symmetry, double density, Generator& random) {
+        SoupBuffer board(width, height, needsSquare(symmetry));
+        fillDomain(board, symmetry, density, random);
+
+        // OR together the images of the domain under every group element. Each orbit has exactly one cell in the
+        // domain, so this sets whole orbits to that cell's value without disturbing the density.
+        switch (symmetry) {
+        case C1:
+            break;
+        case C2:
+            board.orWith(board.mirroredX().mirroredY());
+            break;
+        case D4: {
+            SoupBuffer x = board.mirroredX();
+            board.orWith(x);
+            board.orWith(board.mirroredY()); // Mirrors both the domain and its x-image
+            break;
+        }
+        case C4: {
+            SoupBuffer t = board.transposed();
+            SoupBuffer r90 = t.mirroredX(), r270 = t.mirroredY();
+            SoupBuffer r180 = board.mirroredX().mirroredY();
+            board.orWith(r90);
+            board.orWith(r180);
+            board.orWith(r270);
+            break;
+        }
+        case D8: {
+            board.orWith(board.transposed());
+            board.orWith(board.mirroredX());
+            board.orWith(board.mirroredY());
+            break;
+        }
+        }
+        return board.packed();
+    }
+
+    // Reverse the order of the 64 bits of a word.
+    static uint64_t reverse(uint64_t v) {
+        v = ((v >> 1) & 0x5555555555555555ULL) | ((v & 0x5555555555555555ULL) << 1);
+        v = ((v >> 2) & 0x3333333333333333ULL) | ((v & 0x3333333333333333ULL) << 2);
+        v = ((v >> 4) & 0x0F0F0F0F0F0F0F0FULL) | ((v & 0x0F0F0F0F0F0F0F0FULL) << 4);
+        return __builtin_bswap64(v);
+    }
+
+    // Transpose a 64x64 bit matrix in place: bit x of word y swaps with bit y of word x. Each round swaps the
+    // off-diagonal quarters of every 2j x 2j block at once (Hacker's Delight 7-3, for least-significant-bit-first rows).
+    static void transpose(uint64_t (&a)[64]) {
+        uint64_t mask = 0x00000000FFFFFFFFULL;
+        for (int j = 32; j != 0; j >>= 1, mask ^= mask << j) {
+            for (int k = 0; k < 64; k = ((k | j) + 1) & ~j) {
+                uint64_t t = ((a[k] >> j) ^ a[k | j]) & mask;
+                a[k] ^= t << j;
+                a[k | j] ^= t;
+            }
+        }
+    }
+
+private:
+    // Rows start on word boundaries, so mirrors and transposes work on whole words. Square buffers are padded to a
+    // whole number of 64x64 blocks; padding cells are always 0.
+    struct SoupBuffer {
+        int width, height, stride, rows;
+        std::vector<uint64_t> words;
+
+        SoupBuffer(int width, int height, bool square)
+            : width(width), height(height), stride((width + 63) >> 6),
+              rows(square ? stride * 64 : height), words(size_t(stride) * rows, 0) {}
+
+        uint64_t* row(int y) { return &words[size_t(y) * stride]; }
+        const uint64_t* row(int y) const { return &words[size_t(y) * stride]; }
+
+        void orWith(const SoupBuffer& other) {
+            for (size_t i = 0; i < words.size(); ++i) words[i] |= other.words[i];
+        }
+
+        // x -> width - 1 - x: reverse the word order and the bits of each word, then shift out the padding.
+        SoupBuffer mirroredX() const {
+            SoupBuffer out(*this);
+            int pad = stride * 64 - width;
+            for (int y = 0; y < height; ++y) {
+                const uint64_t* in = row(y);
+                uint64_t* o = out.row(y);
+                for (int i = 0; i < stride; ++i) o[i] = reverse(in[stride - 1 - i]);
+                if (pad == 0) continue;
+                for (int i = 0; i < stride; ++i) {
+                    o[i] = (o[i] >> pad) | (i + 1 < stride ? o[i + 1] << (64 - pad) : 0);
+                }
+            }
+            return out;
+        }
+
+        // y -> height - 1 - y.
+        SoupBuffer mirroredY() const {
+            SoupBuffer out(*this);
+            for (int y = 0; y < height; ++y) {
+                std::memcpy(out.row(y), row(height - 1 - y), stride * sizeof(uint64_t));
+            }
+            return out;
+        }
+
+        // (x, y) -> (y, x), square buffers only: block (bx, by) is transposed into block (by, bx).
+        SoupBuffer transposed() const {
+            SoupBuffer out(*this);
+            uint64_t block[64];
+            for (int by = 0; by < stride; ++by) {
+                for (int bx = 0; bx < stride; ++bx) {
+                    for (int r = 0; r < 64; ++r) block[r] = row(by * 64 + r)[bx];
+                    transpose(block);
+                    for (int r = 0; r < 64; ++r) out.row(bx * 64 + r)[by] = block[r];
+                }
+            }
+            return out;
+        }
+
+        DynamicBitset packed() const {
+            DynamicBitset out(size_t(width) * height);
+            for (int y = 0; y < height; ++y) {
+                for (int i = 0; i < stride; ++i) {
+                    out.setBits(size_t(y) * width + (i << 6), std::min(64, width - (i << 6)), row(y)[i]);
+                }
+            }
+            return out;
+        }
+    };
+
+    // Low `count` bits set.
+    static uint64_t lowBits(int count) {
+        return count >= 64 ? ~uint64_t(0) : count <= 0 ? 0 : (uint64_t(1) << count) - 1;
+    }
+
+    template <class Generator>
+    static uint64_t randomWord(Generator& random, double density) {
+        if (density == 0.5) return random(); // One draw per 64 cells
+        std::bernoulli_distribution alive(std::min(1.0, std::max(0.0, density)));
+        uint64_t word = 0;
+        for (int b = 0; b < 64; ++b) word |= uint64_t(alive(random)) << b;
+        return word;
+    }
+
+    // Fill row y of the domain, columns [0, limit), with random cells.
+    template <class Generator>
+    static void fillRow(SoupBuffer& board, int y, int limit, double density, Generator& random) {
+        uint64_t* row = board.row(y);
+        for (int i = 0; (i << 6) < limit; ++i) {
+            row[i] = randomWord(random, density) & lowBits(limit - (i << 6));
+        }
+    }
+
+    // Draw the fundamental domain: exactly one cell of every orbit of the symmetry group.
+    template <class Generator>
+    static void fillDomain(SoupBuffer& board, Symmetry symmetry, double density, Generator& random) {
+        int w = board.width, h = board.height;
+        switch (symmetry) {
+        case C1:
+            for (int y = 0; y < h; ++y) fillRow(board, y, w, density, random);
+            break;
+        case C2: // The top half, and the left half of an odd middle row
+            for (int y = 0; y < h / 2; ++y) fillRow(board, y, w, density, random);
+            if (h % 2) fillRow(board, h / 2, (w + 1) / 2, density, random);
+            break;
+        case D4: // The top-left quadrant, including odd middle rows and columns
+            for (int y = 0; y < (h + 1) / 2; ++y) fillRow(board, y, (w + 1) / 2, density, random);
+            break;
+        case C4: // A pinwheel blade: rows [0, n/2), columns [0, (n+1)/2), plus the center cell of an odd board
+            for (int y = 0; y < w / 2; ++y) fillRow(board, y, (w + 1) / 2, density, random);
+            if (w % 2) board.row(w / 2)[(w / 2) >> 6] |= (randomWord(random, density) & 1) << ((w / 2) & 63);
+            break;
+        case D8: // The part of the top-left quadrant on or below the diagonal
+            for (int y = 0; y < (w + 1) / 2; ++y) fillRow(board, y, y + 1, density, random);
+            break;
+        }
+    }
+};
+
+} // namespace gol
+
+#endif // GOL_SYMMETRIC_SOUP_H
@@ -0,0 +1,57 @@
+#ifndef GOL_TERMINAL_INPUT_H
+#define GOL_TERMINAL_INPUT_H
+
+#include <termios.h>
+#include <unistd.h>
+
+namespace gol {
+
+// Puts the terminal in non-blocking raw mode for the lifetime of the object so keys can be polled between frames.
+// Signals are not generated from the keyboard in raw mode; Ctrl-C is reported as a key instead.
+class TerminalInput {
+public:
+    enum Key { NONE = -1, UP = 1000, DOWN, LEFT, RIGHT };
+
+    TerminalInput() {
+        if (!isatty(STDIN_FILENO) || tcgetattr(STDIN_FILENO, &saved) != 0) return;
+
+        termios raw = saved;
+        raw.c_lflag &= ~(ICANON | ECHO | ISIG);
+        raw.c_cc[VMIN] = 0;
+        raw.c_cc[VTIME] = 0;
+        tcsetattr(STDIN_FILENO, TCSANOW, &raw); // VMIN = VTIME = 0: read returns at once when no key is waiting
+        active = true;
+    }
+
+    ~TerminalInput() {
+        if (!active) return;
+        tcsetattr(STDIN_FILENO, TCSANOW, &saved);
+    }
+
+    // Next pending key, or NONE. Arrow-key escape sequences are decoded to UP/DOWN/LEFT/RIGHT.
+    int poll() {
+        unsigned char c;
+        if (!active || ::read(STDIN_FILENO, &c, 1) != 1) return NONE;
+        if (c != 0x1B) return c;
+
+        unsigned char seq[2];
+        if (::read(STDIN_FILENO, &seq[0], 1) != 1 || seq[0] != '[' || ::read(STDIN_FILENO, &seq[1], 1) != 1) {
+            return 0x1B;
+        }
+        switch (seq[1]) {
+            case 'A': return UP;
+            case 'B': return DOWN;
+            case 'C': return RIGHT;
+            case 'D': return LEFT;
+            default: return NONE;
+        }
+    }
+
+private:
+    termios saved{};
+    bool active = false;
+};
+
+} // namespace gol
+
+#endif // GOL_TERMINAL_INPUT_H
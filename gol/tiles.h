@@ -0,0 +1,97 @@
+#ifndef GOL_TILES_H
+#define GOL_TILES_H
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "dynamic_bitset.h"
+
+namespace gol {
+
+// The board split into 64x64 tiles, with a flag per tile marking which ones changed between two generations.
+class ChangedTiles {
+public:
+    static constexpr int SHIFT = 6;
+    static constexpr int SIZE = 1 << SHIFT;
+
+    ChangedTiles(int width, int height)
+        : width(width), tilesX((width + SIZE - 1) >> SHIFT), tilesY((height + SIZE - 1) >> SHIFT),
+          flags(size_t(tilesX) * tilesY, 0) {}
+
+    // Mark every tile containing a cell that differs between before and after.
+    void compute(const DynamicBitset& before, const DynamicBitset& after) {
+        clear();
+        const uint64_t* a = before.wordData();
+        const uint64_t* b = after.wordData();
+        for (size_t w = 0; w < before.words(); ++w) {
+            uint64_t diff = a[w] ^ b[w];
+            while (diff) {
+                size_t cell = w * 64 + __builtin_ctzll(diff);
+                int y = int(cell / width), x = int(cell % width);
+                mark(x >> SHIFT, y >> SHIFT);
+
+                // Skip the rest of this tile's span of the row; it cannot mark anything new.
+                size_t spanEnd = size_t(y) * width + std::min(width, ((x >> SHIFT) + 1) << SHIFT);
+                if (spanEnd >= (w + 1) * 64) break;
+                diff &= ~uint64_t(0) << (spanEnd - w * 64);
+            }
+        }
+    }
+
+    void mark(int tx, int ty) {
+        uint8_t& flag = flags[size_t(ty) * tilesX + tx];
+        if (!flag) {
+            flag = 1;
+            changed.push_back(ty * tilesX + tx);
+        }
+    }
+
+    void clear() {
+        for (int tile : changed) flags[tile] = 0;
+        changed.clear();
+    }
+
+    bool test(int tx, int ty) const { return flags[size_t(ty) * tilesX + tx]; }
+    const std::vector<int>& list() const { return changed; } // Tile indices, ty * tilesX + tx
+    int columns() const { return tilesX; }
+    int rows() const { return tilesY; }
+
+private:
+    int width, tilesX, tilesY;
+    std::vector<uint8_t> flags;
+    std::vector<int> changed;
+};
+
+// One 64x64 tile of a board: bit x of rows[y] is cell (tileX * 64 + x, tileY * 64 + y).
+struct Tile {
+    uint64_t rows[ChangedTiles::SIZE];
+
+    void load(const DynamicBitset& grid, int width, int height, int tx, int ty) {
+        int x = tx << ChangedTiles::SHIFT;
+        int span = std::min(ChangedTiles::SIZE, width - x);
+        for (int r = 0; r < ChangedTiles::SIZE; ++r) {
+            int y = (ty << ChangedTiles::SHIFT) + r;
+            rows[r] = y < height ? grid.bits(size_t(y) * width + x, span) : 0;
+        }
+    }
+
+    void store(DynamicBitset& grid, int width, int height, int tx, int ty) const {
+        int x = tx << ChangedTiles::SHIFT;
+        int span = std::min(ChangedTiles::SIZE, width - x);
+        for (int r = 0; r < ChangedTiles::SIZE; ++r) {
+            int y = (ty << ChangedTiles::SHIFT) + r;
+            if (y < height) grid.setBits(size_t(y) * width + x, span, rows[r]);
+        }
+    }
+
+    bool empty() const {
+        uint64_t any = 0;
+        for (uint64_t row : rows) any |= row;
+        return any == 0;
+    }
+};
+
+} // namespace gol
+
+#endif // GOL_TILES_H
@@ -1,229 +1,291 @@
-#include <iostream>
-#include <bitset>
-#include <chrono>
-#include <thread>
+#include <algorithm>
 #include <cstdlib>
 #include <cstring>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
 
-/**
- * Cellular Automaton
- *
- * Goals
- *  - Implement a simple cellular automaton simulation using the Game of Life rules.
- *  - Use a DynamicBitset class to manage the grid state.
- *  - Display the grid state in the console.
- *  - Measure the time taken for each iteration and the total time for the simulation.
- *  - Allow customization of the board dimensions and speed of the simulation.
- *  - Allow to run concurrent simulations with different parameters (like percentage of cells alive).
- *  - Search for stable or oscillating patterns in the grid.
- * */
-
-// A DynamicBitset class that allows for dynamic allocation of bits on the heap and provides a safe interface for reading and writing bit values. 
-// Likely to be slower than std::vector<bool>... but it's a good exercise in memory management and operator overloading.
-// Potentially more memory efficient than std::vector<bool> since std::bitset<1> is a single bit in size.
-class DynamicBitset {
-public:
-    DynamicBitset(int size) : size(size), data(new std::bitset<1>[size]()) {}
+#include "gol/batch_runner.h"
+#include "gol/board_scheduler.h"
+#include "gol/cellular_automaton.h"
+#include "gol/metrics.h"
+#include "gol/pattern.h"
+#include "gol/result_cache.h"
+#include "gol/seed.h"
+#include "gol/signals.h"
 
-    DynamicBitset(const DynamicBitset& other) : size(other.size), data(new std::bitset<1>[other.size]) {
-        for (int i = 0; i < size; ++i) {
-            data[i] = other.data[i];
-        }
-    }
+using namespace gol;
 
-    DynamicBitset& operator=(const DynamicBitset& other) {
-        if (this == &other) return *this; // Handle self-assignment
+int main(int argc, char *argv[]) {
+    int width = 32, height = 32;
+    int speed = 100;
+    bool displayEnabled = true;
+    bool heatmapEnabled = false, heatmapDisplay = false;
+    int heatmapWindow = 0;
+    bool agesEnabled = false;
+    std::string framePrefix;
+    FrameExporter::Format frameFormat = FrameExporter::PNG;
+    int exportThreads = std::max(1u, std::thread::hardware_concurrency());
+    std::string sharedName;
+    std::string socketPath;
+    std::string metricsPath;
+    std::string checkpointPath, resumePath;
+    int generationsPerFrame = 1;
+    int viewX = 0, viewY = 0, viewZoom = 0;
+    int historySize = 0;
+    int rewindSize = 0;
+    std::string findPath;
+    std::string trackPath;
+    int coneX = 0, coneY = 0, coneW = 0, coneH = 0, coneGenerations = -1;
+    std::string heatmapPath;
+    int batchBoards = 0;
+    int batchThreads = std::max(1u, std::thread::hardware_concurrency());
+    int batchQuantum = 64;
+    int maxGenerations = 10000;
+    std::string jobsPath;
+    std::string cachePath;
+    std::string symmetryName;
+    uint64_t masterSeed = uint64_t(std::random_device()()) << 32 | std::random_device()();
 
-        delete[] data; // Free existing memory
-        size = other.size;
-        data = new std::bitset<1>[size];
-        for (int i = 0; i < size; ++i) {
-            data[i] = other.data[i];
+    // Parse command-line arguments
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "-w") == 0 && i + 1 < argc) {
+            width = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "-h") == 0 && i + 1 < argc) {
+            height = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "-s") == 0 && i + 1 < argc) {
+            speed = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "-nd") == 0) {
+            displayEnabled = false;
+        } else if (std::strcmp(argv[i], "-hm") == 0 && i + 1 < argc) {
+            heatmapEnabled = true;
+            heatmapPath = argv[++i];
+        } else if (std::strcmp(argv[i], "-hw") == 0 && i + 1 < argc) {
+            heatmapEnabled = true;
+            heatmapWindow = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "-hd") == 0) {
+            heatmapEnabled = true;
+            heatmapDisplay = true;
+        } else if (std::strcmp(argv[i], "-age") == 0) {
+            agesEnabled = true;
+        } else if (std::strcmp(argv[i], "-png") == 0 && i + 1 < argc) {
+            frameFormat = FrameExporter::PNG;
+            framePrefix = argv[++i];
+        } else if (std::strcmp(argv[i], "-ppm") == 0 && i + 1 < argc) {
+            frameFormat = FrameExporter::PPM;
+            framePrefix = argv[++i];
+        } else if (std::strcmp(argv[i], "-ej") == 0 && i + 1 < argc) {
+            exportThreads = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "-shm") == 0 && i + 1 < argc) {
+            sharedName = argv[++i];
+        } else if (std::strcmp(argv[i], "-serve") == 0 && i + 1 < argc) {
+            socketPath = argv[++i];
+        } else if (std::strcmp(argv[i], "-metrics") == 0 && i + 1 < argc) {
+            metricsPath = argv[++i];
+        } else if (std::strcmp(argv[i], "-ckpt") == 0 && i + 1 < argc) {
+            checkpointPath = argv[++i];
+        } else if (std::strcmp(argv[i], "-resume") == 0 && i + 1 < argc) {
+            resumePath = argv[++i];
+        } else if (std::strcmp(argv[i], "-gpf") == 0 && i + 1 < argc) {
+            generationsPerFrame = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "-vx") == 0 && i + 1 < argc) {
+            viewX = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "-vy") == 0 && i + 1 < argc) {
+            viewY = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "-zoom") == 0 && i + 1 < argc) {
+            viewZoom = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "-hist") == 0 && i + 1 < argc) {
+            historySize = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "-rewind") == 0 && i + 1 < argc) {
+            rewindSize = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "-track") == 0 && i + 1 < argc) {
+            trackPath = argv[++i];
+        } else if (std::strcmp(argv[i], "-find") == 0 && i + 1 < argc) {
+            findPath = argv[++i];
+        } else if (std::strcmp(argv[i], "-batch") == 0 && i + 1 < argc) {
+            batchBoards = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "-threads") == 0 && i + 1 < argc) {
+            batchThreads = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "-quantum") == 0 && i + 1 < argc) {
+            batchQuantum = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "-maxgen") == 0 && i + 1 < argc) {
+            maxGenerations = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "-seed") == 0 && i + 1 < argc) {
+            masterSeed = std::strtoull(argv[++i], nullptr, 0);
+        } else if (std::strcmp(argv[i], "-sym") == 0 && i + 1 < argc) {
+            symmetryName = argv[++i];
+        } else if (std::strcmp(argv[i], "-cache") == 0 && i + 1 < argc) {
+            cachePath = argv[++i];
+        } else if (std::strcmp(argv[i], "-jobs") == 0 && i + 1 < argc) {
+            jobsPath = argv[++i];
+        } else if (std::strcmp(argv[i], "-cone") == 0 && i + 1 < argc) {
+            if (std::sscanf(argv[++i], "%d,%d,%d,%d,%d", &coneX, &coneY, &coneW, &coneH, &coneGenerations) != 5 ||
+                coneW <= 0 || coneH <= 0 || coneGenerations < 0) {
+                std::cerr << "-cone expects x,y,w,h,generations\n";
+                return 1;
+            }
         }
-        return *this;
     }
 
-    ~DynamicBitset() {
-        delete[] data; // Properly delete allocated memory
+    if (width <= 0 || height <= 0) {
+        std::cerr << "Invalid board dimensions. Width and height must be positive integers.\n";
+        return 1;
     }
 
-    bool test(int index) const {
-        // Safely read the value of a specific bit
-        if (index >= 0 && index < size) {
-            return data[index].test(0);
-        }
-        return false;
+    if (!cachePath.empty() && jobsPath.empty()) {
+        std::cerr << "-cache only applies to -jobs\n";
+        return 1;
     }
 
-    void set(int index, bool value) {
-        // Safely set the value of a specific bit
-        if (index >= 0 && index < size) {
-            data[index] = value ? std::bitset<1>("1") : std::bitset<1>("0");
+    // Run a job file ("-" for stdin) on the batch pool and stream the results as JSON lines.
+    if (!jobsPath.empty()) {
+        std::ifstream file;
+        if (jobsPath != "-") {
+            file.open(jobsPath);
+            if (!file) {
+                std::cerr << "Cannot open job file " << jobsPath << "\n";
+                return 1;
+            }
         }
+        std::unique_ptr<ResultCache> cache;
+        if (!cachePath.empty()) {
+            cache.reset(new ResultCache(cachePath));
+            if (!cache->ok()) {
+                return 1;
+            }
+        }
+        std::unique_ptr<MetricsFileWriter> metrics;
+        if (!metricsPath.empty()) {
+            metrics.reset(new MetricsFileWriter(metricsPath, std::chrono::seconds(1)));
+        }
+        installSignalHandlers(true); // A stop must not wait for the next line from a quiet pipe
+        BatchRunner runner(batchThreads, batchQuantum, masterSeed, std::cout, cache.get());
+        return runner.run(jobsPath == "-" ? std::cin : file) == 0 ? 0 : 2;
     }
 
-    void reset() {
-        // Reset all bits to 0
-        for (int i = 0; i < size; ++i) {
-            data[i].reset();
+    // Run that many random boards to completion on a shared pool, without display, and report the scheduler stats.
+    if (batchBoards > 0) {
+        std::unique_ptr<MetricsFileWriter> metrics;
+        if (!metricsPath.empty()) {
+            metrics.reset(new MetricsFileWriter(metricsPath, std::chrono::seconds(1)));
+        }
+        BoardScheduler scheduler(batchThreads, batchQuantum);
+        for (int i = 0; i < batchBoards; ++i) {
+            uint64_t seed = deriveSeed(masterSeed, i);
+            scheduler.submit(std::unique_ptr<CellularAutomaton>(new CellularAutomaton(width, height, speed, seed)), maxGenerations);
         }
+        scheduler.wait();
+
+        BoardScheduler::Stats stats = scheduler.stats();
+        std::cout << "seed=" << masterSeed << " boards=" << stats.boards << " generations=" << stats.generations << " slices=" << stats.slices
+                  << " seconds=" << stats.seconds << " boards_per_s=" << stats.boardsPerSecond
+                  << " gens_per_s=" << stats.generationsPerSecond << " mean_slowdown=" << stats.meanSlowdown
+                  << " max_slowdown=" << stats.maxSlowdown << " fairness=" << stats.fairness
+                  << " worker_balance=" << stats.workerBalance << "\n";
+        return 0;
     }
 
-    bool operator==(const DynamicBitset& other) const {
-        // Compare two DynamicBitset objects
-        if (size != other.size) return false;
-        for (int i = 0; i < size; ++i) {
-            if (data[i] != other.data[i]) return false;
+    CellularAutomaton ca(width, height, speed, masterSeed);
+    if (!symmetryName.empty()) {
+        SymmetricSoup::Symmetry symmetry;
+        if (!SymmetricSoup::parse(symmetryName, symmetry)) {
+            std::cerr << "-sym expects C1, C2, C4, D4 or D8\n";
+            return 1;
         }
-        return true;
+        if (SymmetricSoup::needsSquare(symmetry) && width != height) {
+            std::cerr << symmetryName << " soups need a square board\n";
+            return 1;
+        }
+        ca.randomize(masterSeed, 0.5, symmetry);
     }
-
-private:
-    int size;
-    std::bitset<1>* data;
-};
-
-
-class CellularAutomaton {
-public:
-    CellularAutomaton(int width, int height, int speed)
-        : width(width), height(height), speed(speed),
-          grid(width * height), nextGrid(width * height), prevGrid(width * height)
-    {
-        initializeRandom();
+    if (heatmapEnabled) {
+        ca.enableHeatmap(heatmapWindow, heatmapPath, heatmapDisplay);
     }
-
-    void run(bool displayEnabled) {
-        std::cout << "\033[2J\033[1;1H"; // Clear screen
-
-        auto startTotal = std::chrono::high_resolution_clock::now();
-        int iteration = 0;
-
-        while (true) {
-            std::cout << "\033[H"; // Move cursor to the top-left
-
-            auto startIter = std::chrono::high_resolution_clock::now();
-            bool isAlive = update();
-            auto endIter = std::chrono::high_resolution_clock::now();
-
-            if (displayEnabled) {
-                display();
-                std::this_thread::sleep_for(std::chrono::milliseconds(speed));
-            }
-
-            if (!isAlive) {
-                std::cout << "Board has reached a stable or alternating state.\n";
-                break;
-            }
-
-            auto iterDuration = std::chrono::duration_cast<std::chrono::microseconds>(endIter - startIter);
-            std::cout << "Iteration " << iteration + 1 << ": " << iterDuration.count() << " microseconds\n";
-
-            iteration++;
-            std::cout << std::flush;
-        }
-
-        auto endTotal = std::chrono::high_resolution_clock::now();
-        std::chrono::duration<double> elapsed = endTotal - startTotal;
-
-        std::cout << "Total time for " << iteration << " iterations: " << elapsed.count() << " seconds\n";
+    if (agesEnabled) {
+        ca.enableAges();
     }
-
-private:
-    int width, height, speed;
-    DynamicBitset grid;
-    DynamicBitset nextGrid;
-    DynamicBitset prevGrid;
-
-    void initializeRandom() {
-        srand(time(0)); // Seed random number generator
-        for (int i = 0; i < width * height; ++i) {
-            grid.set(i, rand() % 2); // Use set method for setting random values
+    if (!framePrefix.empty()) {
+        ca.enableFrameExport(frameFormat, framePrefix, exportThreads);
+    }
+    if (!sharedName.empty() && !ca.enableSharedFrames(sharedName)) {
+        return 1;
+    }
+    if (!socketPath.empty() && !ca.enableFrameServer(socketPath)) {
+        return 1;
+    }
+    ca.setGenerationsPerFrame(generationsPerFrame);
+    ca.setViewport(viewX, viewY, viewZoom);
+    if (historySize > 0) {
+        ca.enableHistory(historySize);
+    }
+    if (rewindSize > 0) {
+        ca.enableRewind(rewindSize);
+    }
+    if (!checkpointPath.empty()) {
+        ca.setCheckpointPath(checkpointPath);
+    }
+    if (!resumePath.empty() && !ca.loadCheckpoint(resumePath)) {
+        return 1;
+    }
+    Pattern findTarget;
+    if (!findPath.empty()) {
+        std::ifstream in(findPath);
+        std::stringstream text;
+        text << in.rdbuf();
+        if (!in || !Pattern::parse(text.str(), findTarget)) {
+            std::cerr << "Cannot read pattern (plaintext or RLE, up to 62x62) from " << findPath << "\n";
+            return 1;
         }
     }
-
-    // TODO: Detect oscillating patterns of periods greater than one. 
-    //       Since I am using the DnyamicBitset class, I can create many copies of the grid state without worrying about memory overhead.
-    bool update() {
-        nextGrid.reset(); // Reset the next grid to all 0s
-
-        for (int y = 0; y < height; ++y) {
-            for (int x = 0; x < width; ++x) {
-                int index = y * width + x;
-                int liveNeighbors = countLiveNeighbors(x, y);
-
-                bool alive = grid.test(index); // Use test to read a cell value
-                nextGrid.set(index, (alive && (liveNeighbors == 2 || liveNeighbors == 3)) ||
-                                     (!alive && liveNeighbors == 3)); // Use set to write a cell value
-            }
+    std::ofstream trackLog;
+    if (!trackPath.empty()) {
+        trackLog.open(trackPath);
+        if (!trackLog) {
+            std::cerr << "Cannot open track log " << trackPath << "\n";
+            return 1;
         }
-
-        if (nextGrid == prevGrid || nextGrid == grid) {
-            return false; // Stable or alternating state detected
+        if (!ca.enableTracking(trackLog)) {
+            std::cerr << "-track needs the B3/S23 rule\n";
+            return 1;
         }
-
-        prevGrid = grid; // Save the current state to prevGrid
-        grid = nextGrid; // Update the current grid to nextGrid
-
-        return true; // Continue simulation
     }
-
-    int countLiveNeighbors(int x, int y) const {
-        int count = 0;
-
-        for (int dy = -1; dy <= 1; ++dy) {
-            for (int dx = -1; dx <= 1; ++dx) {
-                if (dx == 0 && dy == 0) // Skip the current cell
-                    continue;
-
-                int nx = x + dx;
-                int ny = y + dy;
-
-                // Ensure neighbors are within bounds
-                if (nx >= 0 && nx < width && ny >= 0 && ny < height) {
-                    count += grid.test(ny * width + nx); // Use test to read neighbor's value
-                }
-            }
+    installSignalHandlers();
+
+    // Print the requested region at a future generation and exit without running.
+    if (coneGenerations >= 0) {
+        DynamicBitset region(0);
+        if (!ca.regionAt(coneX, coneY, coneW, coneH, coneGenerations, region)) {
+            std::cerr << "-cone needs the B3/S23 rule\n";
+            return 1;
         }
-
-        return count;
-    }
-
-    void display() const {
-        for (int y = 0; y < height; ++y) {
-            for (int x = 0; x < width; ++x) {
-                std::cout << (grid.test(y * width + x) ? "\033[38;5;82m◆\033[0m" : " ");
+        for (int y = 0; y < coneH; ++y) {
+            for (int x = 0; x < coneW; ++x) {
+                std::cout << (region.test(size_t(y) * coneW + x) ? 'O' : '.');
             }
             std::cout << '\n';
         }
+        return 0;
     }
-};
 
-int main(int argc, char *argv[]) {
-    int width = 32, height = 32;
-    int speed = 100;
-    bool displayEnabled = true;
-
-    // Parse command-line arguments
-    for (int i = 1; i < argc; ++i) {
-        if (std::strcmp(argv[i], "-w") == 0 && i + 1 < argc) {
-            width = std::atoi(argv[++i]);
-        } else if (std::strcmp(argv[i], "-h") == 0 && i + 1 < argc) {
-            height = std::atoi(argv[++i]);
-        } else if (std::strcmp(argv[i], "-s") == 0 && i + 1 < argc) {
-            speed = std::atoi(argv[++i]);
-        } else if (std::strcmp(argv[i], "-nd") == 0) {
-            displayEnabled = false;
-        }
-    }
-
-    if (width <= 0 || height <= 0) {
-        std::cerr << "Invalid board dimensions. Width and height must be positive integers.\n";
-        return 1;
+    std::unique_ptr<MetricsFileWriter> metrics;
+    if (!metricsPath.empty()) {
+        metrics.reset(new MetricsFileWriter(metricsPath, std::chrono::seconds(1)));
     }
 
-    CellularAutomaton ca(width, height, speed);
     ca.run(displayEnabled);
 
+    // Report isolated occurrences of the -find pattern in the final board.
+    if (!findPath.empty()) {
+        std::vector<PatternSearch::Match> matches = ca.findPattern(findTarget, true);
+        std::cout << matches.size() << " occurrences of " << findPath << "\n";
+        for (const PatternSearch::Match& m : matches) {
+            std::cout << "  at (" << m.x << ", " << m.y << ") orientation " << m.symmetry << "\n";
+        }
+    }
+
     return 0;
 }
@@ -0,0 +1,27 @@
+#ifndef GOL_TESTS_CHECK_H
+#define GOL_TESTS_CHECK_H
+
+#include <cstdio>
+
+// Minimal assertions for the tests/*_test.cpp programs: CHECK records a failure and carries on, and finish() turns
+// the count into the exit status that make test looks at.
+static int failures = 0;
+
+#define CHECK(cond)                                                                  \
+    do {                                                                             \
+        if (!(cond)) {                                                               \
+            std::fprintf(stderr, "%s:%d: CHECK(%s)\n", __FILE__, __LINE__, #cond);   \
+            failures++;                                                              \
+        }                                                                            \
+    } while (0)
+
+static int finish(const char* name) {
+    if (failures) {
+        std::fprintf(stderr, "%s: %d check(s) failed\n", name, failures);
+        return 1;
+    }
+    std::printf("%s: ok\n", name);
+    return 0;
+}
+
+#endif // GOL_TESTS_CHECK_H
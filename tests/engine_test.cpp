@@ -0,0 +1,116 @@
+// Every registered engine must step like a brute-force reference for its rule and boundary, and engines running the
+// same rule on the same board must agree on the hash and (where they have one) expose the same cells in cellBuffer().
+#include <map>
+#include <memory>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "../gol/engine.h"
+#include "check.h"
+
+namespace {
+
+struct Reference {
+    unsigned birth = 1u << 3, survive = 1u << 2 | 1u << 3;
+    bool torus = false;
+};
+
+// The rule and boundary an engine name stands for: "default" or "<storage>/<rule>/<boundary>/<neighborhood>".
+Reference referenceFor(const std::string& name) {
+    Reference ref;
+    if (name.find("B36S23") != std::string::npos) ref.birth |= 1u << 6;
+    ref.torus = name.find("/torus/") != std::string::npos;
+    return ref;
+}
+
+std::vector<uint8_t> stepReference(const std::vector<uint8_t>& cells, int width, int height, const Reference& ref) {
+    std::vector<uint8_t> next(cells.size());
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            int n = 0;
+            for (int dy = -1; dy <= 1; ++dy) {
+                for (int dx = -1; dx <= 1; ++dx) {
+                    if (!dx && !dy) continue;
+                    int nx = x + dx, ny = y + dy;
+                    if (ref.torus) {
+                        nx = (nx + width) % width;
+                        ny = (ny + height) % height;
+                    } else if (nx < 0 || ny < 0 || nx >= width || ny >= height) {
+                        continue;
+                    }
+                    n += cells[size_t(ny) * width + nx];
+                }
+            }
+            bool alive = cells[size_t(y) * width + x];
+            next[size_t(y) * width + x] = ((alive ? ref.survive : ref.birth) >> n) & 1;
+        }
+    }
+    return next;
+}
+
+} // namespace
+
+int main() {
+    const std::vector<std::pair<int, int>> sizes = {{1, 1}, {5, 7}, {63, 20}, {64, 64}, {65, 33}, {130, 70}};
+    const std::vector<std::string> names = gol::EngineRegistry::instance().names();
+    CHECK(names.size() >= 7);
+
+    for (auto [width, height] : sizes) {
+        std::mt19937_64 random(uint64_t(width) * 1000 + height);
+        std::vector<uint8_t> start(size_t(width) * height);
+        gol::DynamicBitset soup(start.size());
+        for (size_t i = 0; i < start.size(); ++i) {
+            start[i] = random() % 3 == 0;
+            soup.set(i, start[i]);
+        }
+
+        // Hash after 12 generations, keyed by rule and boundary, from the first engine that runs them.
+        std::map<std::pair<unsigned, bool>, uint64_t> hashes;
+        for (const std::string& name : names) {
+            std::unique_ptr<gol::Engine> engine = gol::EngineRegistry::instance().create(name, width, height);
+            Reference ref = referenceFor(name);
+            engine->setRegion(0, 0, width, height, soup);
+
+            std::vector<uint8_t> expected = start;
+            int mismatches = 0;
+            for (int steps : {1, 1, 3, 7}) {
+                engine->step(steps);
+                for (int i = 0; i < steps; ++i) expected = stepReference(expected, width, height, ref);
+
+                gol::DynamicBitset cells = engine->getRegion(0, 0, width, height);
+                gol::CellBuffer buffer = engine->cellBuffer();
+                for (int y = 0; y < height; ++y) {
+                    for (int x = 0; x < width; ++x) {
+                        bool want = expected[size_t(y) * width + x];
+                        mismatches += cells.test(size_t(y) * width + x) != want;
+                        if (buffer.words) mismatches += buffer.test(x, y) != want;
+                    }
+                }
+            }
+            if (mismatches) std::fprintf(stderr, "%s %dx%d: %d mismatched cells\n", name.c_str(), width, height, mismatches);
+            CHECK(mismatches == 0);
+            CHECK(engine->stats().generation == 12);
+
+            auto key = std::make_pair(ref.birth, ref.torus);
+            auto known = hashes.emplace(key, engine->hash());
+            CHECK(known.first->second == engine->hash());
+        }
+    }
+
+    // Word-aligned engines expose their rows; the byte engines have no bit buffer.
+    for (const std::string& name : names) {
+        std::unique_ptr<gol::Engine> engine = gol::EngineRegistry::instance().create(name, 100, 10);
+        gol::CellBuffer buffer = engine->cellBuffer();
+        if (name.rfind("bits/", 0) == 0) {
+            CHECK(buffer.words && buffer.strideBits == 128 && buffer.wordCount == 20);
+        } else if (name.rfind("bytes/", 0) == 0) {
+            CHECK(!buffer.words);
+        } else {
+            CHECK(buffer.words && buffer.strideBits == 100);
+        }
+    }
+
+    return finish("engine_test");
+}
@@ -0,0 +1,94 @@
+// LightCone queries must match stepping the whole board, whether they start from the grid or from tiles cached by
+// earlier queries on the same board state.
+#include <random>
+#include <vector>
+
+#include "../gol/cellular_automaton.h"
+#include "../gol/light_cone.h"
+#include "check.h"
+
+namespace {
+
+// One B3/S23 generation of the whole board, edges dead.
+gol::DynamicBitset stepBoard(const gol::DynamicBitset& cells, int width, int height) {
+    gol::DynamicBitset next(size_t(width) * height);
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            int n = 0;
+            for (int dy = -1; dy <= 1; ++dy) {
+                for (int dx = -1; dx <= 1; ++dx) {
+                    int nx = x + dx, ny = y + dy;
+                    if ((dx || dy) && nx >= 0 && ny >= 0 && nx < width && ny < height) {
+                        n += cells.test(size_t(ny) * width + nx);
+                    }
+                }
+            }
+            next.set(size_t(y) * width + x, n == 3 || (n == 2 && cells.test(size_t(y) * width + x)));
+        }
+    }
+    return next;
+}
+
+bool sameAsBoard(const gol::DynamicBitset& region, const gol::DynamicBitset& board, int width, int height, int x0,
+                 int y0, int w, int h) {
+    for (int y = 0; y < h; ++y) {
+        for (int x = 0; x < w; ++x) {
+            int bx = x0 + x, by = y0 + y;
+            bool want = bx >= 0 && by >= 0 && bx < width && by < height && board.test(size_t(by) * width + bx);
+            if (region.test(size_t(y) * w + x) != want) return false;
+        }
+    }
+    return true;
+}
+
+struct Query {
+    int x, y, w, h, n;
+};
+
+} // namespace
+
+int main() {
+    const int width = 200, height = 150, generations = 40;
+    std::mt19937_64 random(42);
+    std::vector<gol::DynamicBitset> boards;
+    boards.emplace_back(size_t(width) * height);
+    for (size_t i = 0; i < size_t(width) * height; ++i) boards[0].set(i, random() % 3 == 0);
+    for (int n = 1; n <= generations; ++n) boards.push_back(stepBoard(boards.back(), width, height));
+
+    // Overlapping and repeated queries share one cache; the later ones start from cached tiles.
+    const std::vector<Query> queries = {
+        {90, 60, 10, 10, 20}, {90, 60, 10, 10, 20}, {92, 58, 12, 8, 25}, {90, 60, 10, 10, 40}, {85, 65, 30, 5, 30},
+        {0, 0, 7, 9, 15},     {190, 140, 10, 10, 12}, {-5, -5, 12, 12, 10}, {195, 70, 20, 3, 18}, {64, 64, 64, 64, 8},
+        {63, 0, 2, 150, 5},   {10, 10, 1, 1, 0},    {300, 300, 5, 5, 10}, {-50, 20, 10, 10, 30},
+    };
+    gol::LightCone cone(width, height);
+    for (const Query& q : queries) {
+        gol::DynamicBitset region = cone.query(boards[0], 1, q.x, q.y, q.w, q.h, q.n);
+        bool ok = sameAsBoard(region, boards[q.n], width, height, q.x, q.y, q.w, q.h);
+        if (!ok) std::fprintf(stderr, "query %d,%d %dx%d +%d differs\n", q.x, q.y, q.w, q.h, q.n);
+        CHECK(ok);
+    }
+
+    // A new version drops the cache: the same rectangle on a later board state.
+    gol::DynamicBitset later = cone.query(boards[10], 2, 90, 60, 10, 10, 20);
+    CHECK(sameAsBoard(later, boards[30], width, height, 90, 60, 10, 10));
+
+    // Empty rectangles come back empty.
+    CHECK(cone.query(boards[0], 2, 10, 10, 0, 5, 3) == gol::DynamicBitset(0));
+
+    // Through the automaton: regionAt agrees with stepping, and refuses rules the cone cannot step.
+    gol::CellularAutomaton automaton(width, height, 0, 7);
+    gol::DynamicBitset ahead(0);
+    CHECK(automaton.regionAt(50, 40, 30, 20, 16, ahead));
+    automaton.step(16);
+    CHECK(ahead == automaton.region(50, 40, 30, 20));
+
+    gol::LifeRule highLife;
+    CHECK(gol::LifeRule::parse("B36/S23", highLife));
+    CHECK(automaton.setRule(highLife));
+    gol::DynamicBitset untouched(4);
+    CHECK(!automaton.regionAt(0, 0, 2, 2, 1, untouched));
+    CHECK(untouched == gol::DynamicBitset(4));
+
+    return finish("light_cone_test");
+}
@@ -0,0 +1,91 @@
+// ResultCache must keep every outcome through several doublings of its table and across a close and reopen, tell
+// apart keys that differ in any one field, and refuse a second open of a file that is in use.
+#include <cstdio>
+#include <string>
+#include <unistd.h>
+
+#include "../gol/result_cache.h"
+#include "check.h"
+
+namespace {
+
+gol::ResultCache::Key keyFor(int i) {
+    gol::ResultCache::Key key;
+    key.initialHash = 0x9E3779B97F4A7C15ULL * uint64_t(i + 1);
+    key.width = 64 + i % 7;
+    key.height = 48;
+    key.birth = 1 << 3;
+    key.survive = 1 << 2 | 1 << 3;
+    return key;
+}
+
+gol::ResultCache::Outcome outcomeFor(int i) {
+    gol::ResultCache::Outcome outcome;
+    outcome.lifespan = i * 3;
+    outcome.period = 1 + i % 2;
+    outcome.finalPopulation = uint64_t(i) * 17;
+    outcome.finalHash = ~uint64_t(i);
+    outcome.census[gol::Census::BLOCK] = i % 11;
+    outcome.census[gol::Census::GLIDER] = i % 5;
+    return outcome;
+}
+
+bool same(const gol::ResultCache::Outcome& a, const gol::ResultCache::Outcome& b) {
+    return a.lifespan == b.lifespan && a.period == b.period && a.finalPopulation == b.finalPopulation &&
+           a.finalHash == b.finalHash && a.census == b.census;
+}
+
+// Every inserted key is found with its outcome; keys never inserted, or differing in one field, are not.
+int lookupMistakes(gol::ResultCache& cache, int count) {
+    int mistakes = 0;
+    for (int i = 0; i < count; ++i) {
+        gol::ResultCache::Outcome outcome;
+        mistakes += !cache.lookup(keyFor(i), outcome) || !same(outcome, outcomeFor(i));
+
+        gol::ResultCache::Key other = keyFor(i);
+        switch (i % 5) {
+        case 0: other.initialHash ^= 1; break;
+        case 1: other.height++; break;
+        case 2: other.birth |= 1 << 6; break;
+        case 3: other.survive = 0; break;
+        case 4: other.boundary = 1; break;
+        }
+        mistakes += cache.lookup(other, outcome);
+    }
+    gol::ResultCache::Outcome outcome;
+    mistakes += cache.lookup(keyFor(count), outcome);
+    return mistakes;
+}
+
+} // namespace
+
+int main() {
+    const std::string path = "/tmp/gol_result_cache_test_" + std::to_string(getpid()) + ".bin";
+    const int count = 1000; // Grows the 64-slot table five times
+    std::remove(path.c_str());
+
+    {
+        gol::ResultCache cache(path, 1);
+        CHECK(cache.ok());
+        for (int i = 0; i < count; ++i) {
+            cache.insert(keyFor(i), outcomeFor(i));
+            if (i % 97 == 0) CHECK(lookupMistakes(cache, i + 1) == 0);
+        }
+        cache.insert(keyFor(0), outcomeFor(0)); // Already present: not stored twice
+        CHECK(cache.size() == uint64_t(count));
+        CHECK(lookupMistakes(cache, count) == 0);
+
+        gol::ResultCache busy(path);
+        CHECK(!busy.ok());
+    }
+
+    {
+        gol::ResultCache reopened(path, 1 << 20); // An existing file keeps its own capacity
+        CHECK(reopened.ok());
+        CHECK(reopened.size() == uint64_t(count));
+        CHECK(lookupMistakes(reopened, count) == 0);
+    }
+
+    std::remove(path.c_str());
+    return finish("result_cache_test");
+}
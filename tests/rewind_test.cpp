@@ -0,0 +1,46 @@
+// Stepping, rewinding and editing must keep the rewind buffer and the generation counter in step with the board.
+#include <vector>
+
+#include "../gol/cellular_automaton.h"
+#include "check.h"
+
+int main() {
+    const int generations = 40;
+    gol::CellularAutomaton ca(64, 48, 0, 7);
+    ca.enableRewind(128, 8);
+
+    std::vector<uint64_t> hashes{ca.hash()};
+    for (int g = 1; g <= generations; ++g) {
+        CHECK(ca.tick());
+        CHECK(ca.currentGeneration() == g);
+        hashes.push_back(ca.hash());
+    }
+
+    // Back to the start one generation at a time, then forward again.
+    for (int g = generations - 1; g >= 0; --g) {
+        CHECK(ca.seekGeneration(g));
+        CHECK(ca.currentGeneration() == g);
+        CHECK(ca.hash() == hashes[g]);
+    }
+    for (int g = 1; g <= generations; ++g) {
+        CHECK(ca.seekGeneration(g));
+        CHECK(ca.hash() == hashes[g]);
+    }
+    CHECK(!ca.seekGeneration(generations + 1));
+    CHECK(ca.hash() == hashes[generations]);
+
+    // An edit amends the generation on screen and drops only the later ones.
+    CHECK(ca.seekGeneration(20));
+    ca.toggleCell(10, 10);
+    uint64_t edited = ca.hash();
+    CHECK(edited != hashes[20]);
+    CHECK(!ca.seekGeneration(21));
+    CHECK(ca.tick());
+    CHECK(ca.currentGeneration() == 21);
+    CHECK(ca.seekGeneration(20));
+    CHECK(ca.hash() == edited);
+    CHECK(ca.seekGeneration(19));
+    CHECK(ca.hash() == hashes[19]);
+
+    return finish("rewind_test");
+}
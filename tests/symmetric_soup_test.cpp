@@ -0,0 +1,97 @@
+// Symmetric soups must be invariant under every element of their group, checked cell by cell against naive mirrors
+// and transposes, and the word-level reverse() and transpose() must match their bit-by-bit definitions.
+#include <random>
+#include <vector>
+
+#include "../gol/seed.h"
+#include "../gol/symmetric_soup.h"
+#include "check.h"
+
+namespace {
+
+using gol::SymmetricSoup;
+
+// Cells the soup must agree on with (x, y) for the board to have the symmetry.
+std::vector<std::pair<int, int>> images(SymmetricSoup::Symmetry symmetry, int x, int y, int width, int height) {
+    int mx = width - 1 - x, my = height - 1 - y;
+    switch (symmetry) {
+    case SymmetricSoup::C1:
+        return {};
+    case SymmetricSoup::C2:
+        return {{mx, my}};
+    case SymmetricSoup::D4:
+        return {{mx, y}, {x, my}, {mx, my}};
+    case SymmetricSoup::C4:
+        return {{my, x}, {mx, my}, {y, mx}};
+    case SymmetricSoup::D8:
+        return {{my, x}, {mx, my}, {y, mx}, {mx, y}, {x, my}, {y, x}, {my, mx}};
+    }
+    return {};
+}
+
+int population(const gol::DynamicBitset& cells, size_t size) {
+    int alive = 0;
+    for (size_t i = 0; i < size; ++i) alive += cells.test(i);
+    return alive;
+}
+
+} // namespace
+
+int main() {
+    const std::vector<std::pair<int, int>> sizes = {{1, 1}, {2, 2}, {7, 7}, {9, 4}, {63, 63}, {64, 64}, {65, 65},
+                                                    {100, 37}, {128, 128}, {130, 130}};
+    for (SymmetricSoup::Symmetry symmetry :
+         {SymmetricSoup::C1, SymmetricSoup::C2, SymmetricSoup::C4, SymmetricSoup::D4, SymmetricSoup::D8}) {
+        for (auto [width, height] : sizes) {
+            if (SymmetricSoup::needsSquare(symmetry) && width != height) continue;
+            for (double density : {0.5, 0.3}) {
+                gol::SplitMix64 random(uint64_t(width) * 131 + height + symmetry);
+                gol::DynamicBitset soup = SymmetricSoup::generate(width, height, symmetry, density, random);
+                int broken = 0;
+                for (int y = 0; y < height; ++y) {
+                    for (int x = 0; x < width; ++x) {
+                        bool alive = soup.test(size_t(y) * width + x);
+                        for (auto [ix, iy] : images(symmetry, x, y, width, height)) {
+                            broken += soup.test(size_t(iy) * width + ix) != alive;
+                        }
+                    }
+                }
+                if (broken) {
+                    std::fprintf(stderr, "%s %dx%d density %.1f: %d asymmetric cells\n", SymmetricSoup::name(symmetry),
+                                 width, height, density, broken);
+                }
+                CHECK(broken == 0);
+
+                // A soup of any size worth looking at is neither empty nor full.
+                if (width * height >= 64 * 64) {
+                    int alive = population(soup, size_t(width) * height);
+                    CHECK(alive > width * height / 5 && alive < width * height * 4 / 5);
+                }
+            }
+
+            gol::SplitMix64 none(1), all(1);
+            CHECK(population(SymmetricSoup::generate(width, height, symmetry, 0.0, none), size_t(width) * height) == 0);
+            CHECK(population(SymmetricSoup::generate(width, height, symmetry, 1.0, all), size_t(width) * height) ==
+                  width * height);
+        }
+    }
+
+    std::mt19937_64 random(5);
+    for (int round = 0; round < 100; ++round) {
+        uint64_t word = random(), reversed = 0;
+        for (int b = 0; b < 64; ++b) reversed |= ((word >> b) & 1) << (63 - b);
+        CHECK(SymmetricSoup::reverse(word) == reversed);
+    }
+    for (int round = 0; round < 10; ++round) {
+        uint64_t matrix[64], original[64];
+        for (int r = 0; r < 64; ++r) original[r] = matrix[r] = random();
+        SymmetricSoup::transpose(matrix);
+        int wrong = 0;
+        for (int y = 0; y < 64; ++y) {
+            for (int x = 0; x < 64; ++x) wrong += ((matrix[y] >> x) & 1) != ((original[x] >> y) & 1);
+        }
+        CHECK(wrong == 0);
+    }
+
+    return finish("symmetric_soup_test");
+}